@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cassert>
 #include <cstddef>
-#include <vector>
-#include <numeric>
 #include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 #include "edge_list.hpp"
+#include "parallel_csr.hpp"
 
 
 // The interface is designed to iterate over all neighbors of a node v
@@ -24,9 +28,11 @@ public:
     using NodeHandle = Index;
     using EdgeIterator = typename std::vector<NodeHandle>::const_iterator;
 
-    explicit AdjacencyArrayT(std::size_t num_nodes = 0, const EdgeList &edges = {})
+    template<class E = Edge>
+    explicit AdjacencyArrayT(std::size_t num_nodes = 0, const std::vector<E> &edges = {})
             : index_(num_nodes + 1), edges_(edges.size()) {
-        if (num_nodes > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+        if (num_nodes > static_cast<std::size_t>(std::numeric_limits<Index>::max()) ||
+            edges.size() > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
             throw std::runtime_error("NodeIdType too small");
         }
 
@@ -42,10 +48,18 @@ public:
         assert(c[num_nodes] == edges.size());
 
         for (const auto &e: edges) {
-            edges_[c[e.from]++] = e.to;
+            edges_[c[e.from]++] = static_cast<NodeHandle>(e.to);
         }
     }
 
+    template<class E>
+    AdjacencyArrayT(ParallelConstruction, std::size_t num_nodes, const std::vector<E> &edges)
+            : edges_(edges.size()) {
+        index_ = parallel_csr::build<Index>(num_nodes, edges, [&](Index position, const E &e) {
+            edges_[position] = static_cast<NodeHandle>(e.to);
+        });
+    }
+
     [[nodiscard]] std::size_t numNodes() const {
         return index_.size() - 1;
     };
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "omp.h"
+
+#include "dijkstra.hpp"
+#include "indexed_priority_queue.hpp"
+#include "reverse_graph.hpp"
+#include "timestamped_vector.hpp"
+#include "weighted_graph_separated.hpp"
+
+// A* search with landmarks and the triangle inequality (ALT) [Goldberg and Harrelson 2005]. Used like DijkstraHelper:
+/*
+  auto helper   = ALTHelper<WeightedGraphSeparated>(graph, 16);
+  auto distance = helper.dijkstra(handle1, handle2);
+*/
+// Landmarks are selected with the farthest heuristic: every new landmark is a reachable node with the largest distance
+// to the already selected landmarks. For every landmark L the distances d(L, v) and d(v, L) are stored. They give the
+// lower bounds d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L), whose maximum is used as the potential of
+// v. Terms with an infinite distance are skipped, unless they prove that t is unreachable from v. Such nodes get an
+// infinite potential and are never queued.
+// After edge weights have changed, updateDistances recomputes the tables without selecting new landmarks.
+
+template<class WeightedGraphClass>
+class ALTHelper {
+private:
+    using GraphType = WeightedGraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using EdgeIterator = typename GraphType::EdgeIterator;
+
+    static constexpr auto infty = std::numeric_limits<double>::infinity();
+
+    const GraphType &graph;
+
+    std::vector<std::size_t> landmarks_{};
+    // node major distance tables, i.e. from_landmark_[v * k + i] = d(landmark i, v)
+    std::vector<double> from_landmark_{};
+    std::vector<double> to_landmark_{};
+
+    TimestampedVector<double> distance{};
+    TimestampedVector<double> potential{};
+    IndexedPriorityQueue<std::size_t, double, std::greater<>> queue;
+
+    void selectLandmarks(std::size_t num_landmarks) {
+        DijkstraHelper<GraphType> dijkstra(graph);
+
+        // the first landmark is the farthest node from node 0, afterwards the farthest node from all landmarks
+        std::vector<double> min_distance = dijkstra.dijkstra(graph.node(0));
+        while (landmarks_.size() < std::min(num_landmarks, graph.numNodes())) {
+            std::size_t farthest = graph.numNodes();
+            double farthest_distance = -1.0;
+            for (std::size_t v = 0; v < graph.numNodes(); ++v) {
+                if (min_distance[v] < infty && min_distance[v] > farthest_distance) {
+                    farthest = v;
+                    farthest_distance = min_distance[v];
+                }
+            }
+            if (farthest == graph.numNodes() || (!landmarks_.empty() && farthest_distance == 0.0)) {
+                break;
+            }
+
+            if (landmarks_.empty()) {
+                min_distance.assign(graph.numNodes(), infty);
+            }
+            landmarks_.push_back(farthest);
+
+            const auto &d = dijkstra.dijkstra(graph.node(farthest));
+            for (std::size_t v = 0; v < graph.numNodes(); ++v) {
+                min_distance[v] = std::min(min_distance[v], d[v]);
+            }
+        }
+    }
+
+    [[nodiscard]] double lowerBound(std::size_t v_id, std::size_t t_id) const {
+        const auto k = landmarks_.size();
+        const double *from_v = &from_landmark_[v_id * k];
+        const double *from_t = &from_landmark_[t_id * k];
+        const double *to_v = &to_landmark_[v_id * k];
+        const double *to_t = &to_landmark_[t_id * k];
+
+        double bound = 0.0;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (from_v[i] < infty) {
+                // L reaches v, but not t
+                if (from_t[i] == infty) return infty;
+                bound = std::max(bound, from_t[i] - from_v[i]);
+            }
+            if (to_t[i] < infty) {
+                // t reaches L, but v does not
+                if (to_v[i] == infty) return infty;
+                bound = std::max(bound, to_v[i] - to_t[i]);
+            }
+        }
+        return bound;
+    }
+
+public:
+    explicit ALTHelper(const GraphType &graph, std::size_t num_landmarks = 16) : graph(graph) {
+        queue.reserve(graph.numNodes());
+        if (graph.numNodes() == 0) return;
+
+        selectLandmarks(num_landmarks);
+        updateDistances();
+    }
+
+    /**
+     * Recomputes the landmark distance tables for the current edge weights. The Dijkstra searches from and to the
+     * landmarks are distributed over the OpenMP threads.
+     */
+    void updateDistances() {
+        const auto n = graph.numNodes();
+        const auto k = landmarks_.size();
+        const WeightedGraphSeparated reverse_graph(n, reversedEdgeList(graph));
+
+        from_landmark_.assign(n * k, infty);
+        to_landmark_.assign(n * k, infty);
+
+        #pragma omp parallel default(none) shared(n, k, reverse_graph)
+        {
+            DijkstraHelper<GraphType> forward(graph);
+            DijkstraHelper<WeightedGraphSeparated> backward(reverse_graph);
+
+            #pragma omp for schedule(dynamic, 1)
+            for (std::size_t task = 0; task < 2 * k; ++task) {
+                auto i = task / 2;
+                if (task % 2 == 0) {
+                    const auto &d = forward.dijkstra(graph.node(landmarks_[i]));
+                    for (std::size_t v = 0; v < n; ++v) from_landmark_[v * k + i] = d[v];
+                } else {
+                    const auto &d = backward.dijkstra(reverse_graph.node(landmarks_[i]));
+                    for (std::size_t v = 0; v < n; ++v) to_landmark_[v * k + i] = d[v];
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] const std::vector<std::size_t> &landmarks() const {
+        return landmarks_;
+    }
+
+    double dijkstra(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0.0;
+        }
+
+        auto start_id = graph.nodeId(start);
+        auto end_id = graph.nodeId(end);
+
+        distance.assign(graph.numNodes(), infty);
+        potential.assign(graph.numNodes(), -1.0);
+        distance.set(start_id, 0.0);
+        potential.set(start_id, lowerBound(start_id, end_id));
+        if (potential[start_id] == infty) {
+            return infty;
+        }
+
+        queue.clear();
+        queue.push(start_id, potential[start_id]);
+
+        // the potentials are consistent, so the distance of end is final once it is taken from the queue
+        while (!queue.empty()) {
+            auto u_id = queue.pop().first;
+            auto u = graph.node(u_id);
+            auto d_u = distance[u_id];
+
+            if (u == end) {
+                return d_u;
+            }
+
+            for (auto e = graph.beginEdges(u); e < graph.endEdges(u); ++e) {
+                auto v_id = graph.nodeId(graph.edgeHead(e));
+                auto d_v_from_u = d_u + graph.edgeWeight(e);
+
+                if (d_v_from_u < distance[v_id]) {
+                    if (potential[v_id] < 0.0) {
+                        potential.set(v_id, lowerBound(v_id, end_id));
+                    }
+                    if (potential[v_id] == infty) continue;
+                    queue.pushOrChangePriority(v_id, d_v_from_u + potential[v_id]);
+                    distance.set(v_id, d_v_from_u);
+                }
+            }
+        }
+        return infty;
+    }
+};
@@ -1,6 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "components.hpp"
+#include "predecessors.hpp"
+#include "timestamped_vector.hpp"
 
 // Construct your BFS implementation here.  It should be used by first creating
 // a BFSHelper with your graph, and then calling bfs on the helper (this should
@@ -13,7 +19,11 @@
   auto distance   = nodeHelper.bfs(handle1, handle2);
 */
 
-template<class GraphClass>
+// With TrackPredecessors the helper also stores the parent of every visited node, and path(end) returns the nodes of a
+// shortest path of the last query. Without it, the parents are never written.
+// After setComponents, queries between nodes that cannot reach each other return without a search.
+
+template<class GraphClass, bool TrackPredecessors = false>
 class BFSHelper {
 private:
     using GraphType = GraphClass;
@@ -24,26 +34,38 @@ private:
 
     std::vector<NodeHandle> frontier{};
     std::vector<NodeHandle> next_frontier{};
-    std::vector<bool> visited{};
+    TimestampedVector<bool> visited{};
+    PredecessorArray predecessors{};
+    const ComponentIndex *components{nullptr};
 
 public:
     explicit BFSHelper(const GraphType &graph) : graph(graph) {
         frontier.reserve(graph.numNodes());
         next_frontier.reserve(graph.numNodes());
-        visited.reserve(graph.numNodes());
+    }
+
+    // Components of the graph to filter unreachable queries, nullptr to search always.
+    void setComponents(const ComponentIndex *index) {
+        components = index;
     }
 
     std::size_t bfs(NodeHandle start, NodeHandle end) {
+        if constexpr (TrackPredecessors) {
+            predecessors.reset(graph.numNodes(), graph.nodeId(start));
+        }
         if (start == end) {
             return 0;
         }
+        if (components && !components->mayReach(graph.nodeId(start), graph.nodeId(end))) {
+            return std::numeric_limits<std::size_t>::max();
+        }
 
         frontier.clear();
         frontier.push_back(start);
         next_frontier.clear();
         visited.assign(graph.numNodes(), false);
 
-        visited[graph.nodeId(start)] = true;
+        visited.set(graph.nodeId(start), true);
 
         std::size_t distance = 1;
 
@@ -55,11 +77,17 @@ public:
                 for (EdgeIterator e = graph.beginEdges(n); e < graph.endEdges(n); ++e) {
                     NodeHandle neighbor = graph.edgeHead(e);
                     if (neighbor == end) {
+                        if constexpr (TrackPredecessors) {
+                            predecessors.set(graph.nodeId(end), graph.nodeId(n));
+                        }
                         return distance;
                     }
                     auto id = graph.nodeId(neighbor);
                     if (!visited[id]) {
-                        visited[id] = true;
+                        visited.set(id, true);
+                        if constexpr (TrackPredecessors) {
+                            predecessors.set(id, graph.nodeId(n));
+                        }
                         next_frontier.push_back(neighbor);
                     }
                 }
@@ -70,4 +98,14 @@ public:
         return std::numeric_limits<std::size_t>::max();
     }
 
+    // Returns the nodes of a shortest path from the start of the last query to end, empty if end was not reached.
+    std::vector<NodeHandle> path(NodeHandle end) const {
+        static_assert(TrackPredecessors, "path requires TrackPredecessors");
+        std::vector<NodeHandle> nodes;
+        for (auto id: predecessors.path(graph.nodeId(end))) {
+            nodes.push_back(graph.node(id));
+        }
+        return nodes;
+    }
+
 };
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "adj_array.hpp"
+#include "weighted_graph_separated.hpp"
+#include "indexed_priority_queue.hpp"
+#include "reverse_graph.hpp"
+#include "timestamped_vector.hpp"
+
+// Bidirectional point-to-point searches. Both helpers build the reverse graph once on construction and are used like
+// BFSHelper and DijkstraHelper:
+/*
+  auto helper   = BidirectionalDijkstraHelper<WeightedGraphSeparated>(graph);
+  auto distance = helper.dijkstra(handle1, handle2);
+*/
+
+template<class GraphClass>
+class BidirectionalBFSHelper {
+private:
+    using GraphType = GraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using EdgeIterator = typename GraphType::EdgeIterator;
+
+    static constexpr auto unvisited = std::numeric_limits<std::size_t>::max();
+
+    const GraphType &graph;
+    AdjacencyArray reverse_graph;
+
+    std::vector<std::size_t> forward_frontier{};
+    std::vector<std::size_t> backward_frontier{};
+    std::vector<std::size_t> next_frontier{};
+    TimestampedVector<std::size_t> forward_distance{};
+    TimestampedVector<std::size_t> backward_distance{};
+
+    // expands one complete level of a search, returns the shortest distance over all meeting points found
+    template<class G, class F>
+    std::size_t expand(const G &g, F &&node_id, std::vector<std::size_t> &frontier, std::size_t level,
+                       TimestampedVector<std::size_t> &distance,
+                       const TimestampedVector<std::size_t> &other_distance) {
+        std::size_t best = unvisited;
+        next_frontier.clear();
+        for (auto u_id: frontier) {
+            auto u = g.node(u_id);
+            for (auto e = g.beginEdges(u); e != g.endEdges(u); ++e) {
+                auto v_id = node_id(g.edgeHead(e));
+                if (distance[v_id] != unvisited) continue;
+                distance.set(v_id, level + 1);
+                next_frontier.push_back(v_id);
+                if (other_distance[v_id] != unvisited) {
+                    best = std::min(best, level + 1 + other_distance[v_id]);
+                }
+            }
+        }
+        std::swap(frontier, next_frontier);
+        return best;
+    }
+
+public:
+    explicit BidirectionalBFSHelper(const GraphType &graph)
+            : graph(graph), reverse_graph(graph.numNodes(), reversedEdgeList(graph)) {
+        forward_frontier.reserve(graph.numNodes());
+        backward_frontier.reserve(graph.numNodes());
+        next_frontier.reserve(graph.numNodes());
+    }
+
+    std::size_t bfs(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0;
+        }
+
+        auto start_id = graph.nodeId(start);
+        auto end_id = graph.nodeId(end);
+
+        forward_distance.assign(graph.numNodes(), unvisited);
+        backward_distance.assign(graph.numNodes(), unvisited);
+        forward_distance.set(start_id, 0);
+        backward_distance.set(end_id, 0);
+
+        forward_frontier.assign(1, start_id);
+        backward_frontier.assign(1, end_id);
+        std::size_t forward_level = 0;
+        std::size_t backward_level = 0;
+
+        // After completing forward level k and backward level l without a meeting point, the distance is larger than
+        // k + l. Hence, the first level with a meeting point yields the shortest distance.
+        while (!forward_frontier.empty() && !backward_frontier.empty()) {
+            std::size_t best;
+            if (forward_frontier.size() <= backward_frontier.size()) {
+                best = expand(graph, [&](NodeHandle v) { return graph.nodeId(v); }, forward_frontier,
+                              forward_level++, forward_distance, backward_distance);
+            } else {
+                best = expand(reverse_graph, [](auto v) { return static_cast<std::size_t>(v); }, backward_frontier,
+                              backward_level++, backward_distance, forward_distance);
+            }
+            if (best != unvisited) {
+                return best;
+            }
+        }
+        return std::numeric_limits<std::size_t>::max();
+    }
+};
+
+
+template<class WeightedGraphClass>
+class BidirectionalDijkstraHelper {
+private:
+    using GraphType = WeightedGraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using EdgeIterator = typename GraphType::EdgeIterator;
+    using Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>;
+
+    static constexpr auto infty = std::numeric_limits<double>::infinity();
+
+    const GraphType &graph;
+    WeightedGraphSeparated reverse_graph;
+
+    TimestampedVector<double> forward_distance{};
+    TimestampedVector<double> backward_distance{};
+    Queue forward_queue;
+    Queue backward_queue;
+
+    // settles the top node of queue and relaxes its edges in g, returns the best path length through its neighbors
+    template<class G, class F>
+    double settle(const G &g, F &&node_id, Queue &queue, TimestampedVector<double> &distance,
+                  const TimestampedVector<double> &other_distance) {
+        auto [u_id, d_u] = queue.pop();
+        auto u = g.node(u_id);
+        double best = infty;
+
+        for (auto e = g.beginEdges(u); e != g.endEdges(u); ++e) {
+            auto v_id = node_id(g.edgeHead(e));
+            auto d_v_from_u = d_u + g.edgeWeight(e);
+
+            if (d_v_from_u < distance[v_id]) {
+                queue.pushOrChangePriority(v_id, d_v_from_u);
+                distance.set(v_id, d_v_from_u);
+            }
+            best = std::min(best, d_v_from_u + other_distance[v_id]);
+        }
+        return best;
+    }
+
+public:
+    explicit BidirectionalDijkstraHelper(const GraphType &graph)
+            : graph(graph), reverse_graph(graph.numNodes(), reversedEdgeList(graph)) {
+        forward_queue.reserve(graph.numNodes());
+        backward_queue.reserve(graph.numNodes());
+    }
+
+    double dijkstra(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0.0;
+        }
+
+        auto start_id = graph.nodeId(start);
+        auto end_id = graph.nodeId(end);
+
+        forward_distance.assign(graph.numNodes(), infty);
+        backward_distance.assign(graph.numNodes(), infty);
+        forward_distance.set(start_id, 0.0);
+        backward_distance.set(end_id, 0.0);
+
+        forward_queue.clear();
+        backward_queue.clear();
+        forward_queue.push(start_id, 0.0);
+        backward_queue.push(end_id, 0.0);
+
+        double shortest = infty;
+
+        // Stop as soon as the sum of both queue minima reaches the shortest path seen so far. Every path that is not
+        // yet known contains a node that is unsettled in both directions and is therefore at least as long.
+        while (!forward_queue.empty() && !backward_queue.empty()) {
+            auto forward_min = forward_queue.top().second;
+            auto backward_min = backward_queue.top().second;
+            if (forward_min + backward_min >= shortest) {
+                break;
+            }
+
+            if (forward_min <= backward_min) {
+                shortest = std::min(shortest, settle(graph, [&](NodeHandle v) { return graph.nodeId(v); },
+                                                     forward_queue, forward_distance, backward_distance));
+            } else {
+                shortest = std::min(shortest, settle(reverse_graph, [](auto v) { return static_cast<std::size_t>(v); },
+                                                     backward_queue, backward_distance, forward_distance));
+            }
+        }
+        return shortest;
+    }
+};
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "edge_list.hpp"
+#include "mapped_file.hpp"
+
+
+/**
+ * Binary CSR graph format.
+ *
+ * Layout (all values in native byte order):
+ *   header            BinaryGraphHeader
+ *   index             (num_nodes + 1) x index_width bytes
+ *   heads             num_edges x index_width bytes
+ *   padding           to a multiple of 8 bytes
+ *   weights           num_edges x double, only if weighted != 0
+ */
+struct BinaryGraphHeader {
+    static constexpr char expected_magic[8] = {'E', 'P', 'C', 'G', 'R', 'A', 'P', 'H'};
+    static constexpr std::uint32_t current_version = 1;
+
+    char magic[8]{};
+    std::uint32_t version{0};
+    std::uint32_t index_width{0};
+    std::uint64_t num_nodes{0};
+    std::uint64_t num_edges{0};
+    std::uint32_t weighted{0};
+    std::uint32_t reserved{0};
+};
+
+static_assert(sizeof(BinaryGraphHeader) % 8 == 0);
+
+namespace binary_graph {
+    [[nodiscard]] inline std::size_t align8(std::size_t offset) {
+        return (offset + 7) / 8 * 8;
+    }
+
+    template<class Index>
+    void writeCSR(std::ofstream &out, std::size_t num_nodes, const EdgeList &edges, bool weighted) {
+        std::vector<Index> c(num_nodes + 1);
+        for (const auto &e: edges) {
+            c[e.from + 1]++;
+        }
+
+        std::inclusive_scan(c.begin(), c.end(), c.begin());
+        out.write(reinterpret_cast<const char *>(c.data()), static_cast<std::streamsize>(c.size() * sizeof(Index)));
+
+        std::vector<Index> heads(edges.size());
+        std::vector<double> weights(weighted ? edges.size() : 0);
+        for (const auto &e: edges) {
+            auto &e_count = c[e.from];
+            heads[e_count] = static_cast<Index>(e.to);
+            if (weighted) weights[e_count] = e.length;
+            e_count++;
+        }
+        out.write(reinterpret_cast<const char *>(heads.data()),
+                  static_cast<std::streamsize>(heads.size() * sizeof(Index)));
+
+        if (weighted) {
+            auto end = sizeof(BinaryGraphHeader) + (num_nodes + 1 + edges.size()) * sizeof(Index);
+            const char zeros[8]{};
+            out.write(zeros, static_cast<std::streamsize>(align8(end) - end));
+            out.write(reinterpret_cast<const char *>(weights.data()),
+                      static_cast<std::streamsize>(weights.size() * sizeof(double)));
+        }
+    }
+}
+
+/**
+ * Writes the graph in the binary CSR format. index_width must be 4 or 8, all edge endpoints must be less than num_nodes.
+ */
+inline void writeBinaryGraph(const std::string &file, std::size_t num_nodes, const EdgeList &edges,
+                             std::uint32_t index_width = 8, bool weighted = true) {
+    if (index_width != 4 && index_width != 8) {
+        throw std::runtime_error("index width must be 4 or 8");
+    }
+    if (index_width == 4 && std::max(num_nodes, edges.size()) > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("NodeIdType too small");
+    }
+    if (std::any_of(edges.begin(), edges.end(),
+                    [num_nodes](const Edge &e) { return e.from >= num_nodes || e.to >= num_nodes; })) {
+        throw std::runtime_error("edge endpoint out of range");
+    }
+
+    BinaryGraphHeader header;
+    std::memcpy(header.magic, BinaryGraphHeader::expected_magic, sizeof(header.magic));
+    header.version = BinaryGraphHeader::current_version;
+    header.index_width = index_width;
+    header.num_nodes = num_nodes;
+    header.num_edges = edges.size();
+    header.weighted = weighted;
+
+    std::ofstream out(file, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("could not open " + file);
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (index_width == 4) {
+        binary_graph::writeCSR<std::uint32_t>(out, num_nodes, edges, weighted);
+    } else {
+        binary_graph::writeCSR<std::uint64_t>(out, num_nodes, edges, weighted);
+    }
+
+    if (!out) {
+        throw std::runtime_error("could not write " + file);
+    }
+}
+
+/**
+ * Read-only graph view over a memory mapped binary CSR file.
+ * The file is mapped and used in place, nothing is copied on construction.
+ * The header and the array sizes are always checked. A file from an untrusted source should be opened with validate set,
+ * which also checks that the index is monotone and all heads are nodes. This reads the whole file, in parallel.
+ * Has the same interface as WeightedGraphSeparatedT. Unweighted files report a weight of 1 for every edge.
+ */
+template<class Index = uint64_t>
+class MappedGraphT {
+public:
+    using NodeHandle = Index;
+    using EdgeIterator = Index;
+
+    explicit MappedGraphT(const std::string &file, bool validate = false) : file_(file) {
+        if (file_.size() < sizeof(BinaryGraphHeader)) {
+            throw std::runtime_error(file + " is not a binary graph");
+        }
+
+        BinaryGraphHeader header;
+        std::memcpy(&header, file_.data(), sizeof(header));
+        if (std::memcmp(header.magic, BinaryGraphHeader::expected_magic, sizeof(header.magic)) != 0) {
+            throw std::runtime_error(file + " is not a binary graph");
+        }
+        if (header.version != BinaryGraphHeader::current_version) {
+            throw std::runtime_error(file + " has unsupported version " + std::to_string(header.version));
+        }
+        if (header.index_width != sizeof(Index)) {
+            throw std::runtime_error(file + " has index width " + std::to_string(header.index_width) +
+                                     ", expected " + std::to_string(sizeof(Index)));
+        }
+
+        // Every array has to fit into the file, which also rules out overflows in the offset arithmetic below.
+        const auto max_entries = file_.size() / sizeof(Index);
+        if (header.num_nodes >= max_entries || header.num_edges > max_entries) {
+            throw std::runtime_error(file + " is truncated");
+        }
+        if (header.num_nodes > std::numeric_limits<Index>::max() ||
+            header.num_edges > std::numeric_limits<Index>::max()) {
+            throw std::runtime_error(file + " has too many nodes or edges for its index width");
+        }
+
+        num_nodes_ = header.num_nodes;
+        auto index_offset = sizeof(BinaryGraphHeader);
+        auto heads_offset = index_offset + (header.num_nodes + 1) * sizeof(Index);
+        auto heads_end = heads_offset + header.num_edges * sizeof(Index);
+        auto weights_offset = binary_graph::align8(heads_end);
+        auto end = header.weighted ? weights_offset + header.num_edges * sizeof(double) : heads_end;
+        if (file_.size() < end) {
+            throw std::runtime_error(file + " is truncated");
+        }
+
+        index_ = reinterpret_cast<const Index *>(file_.data() + index_offset);
+        edges_ = reinterpret_cast<const NodeHandle *>(file_.data() + heads_offset);
+        if (header.weighted) {
+            weights_ = reinterpret_cast<const double *>(file_.data() + weights_offset);
+        }
+
+        if (index_[0] != 0 || index_[num_nodes_] != header.num_edges) {
+            throw std::runtime_error(file + " has an index that does not match the number of edges");
+        }
+        if (validate) {
+            validateArrays(file);
+        }
+    }
+
+    [[nodiscard]] std::size_t numNodes() const {
+        return num_nodes_;
+    };
+
+    [[nodiscard]] std::size_t numEdges() const {
+        return index_[num_nodes_];
+    };
+
+    [[nodiscard]] bool weighted() const {
+        return weights_ != nullptr;
+    }
+
+    [[nodiscard]] NodeHandle node(std::size_t n) const {
+        return n;
+    }
+
+    [[nodiscard]] std::size_t nodeId(NodeHandle n) const {
+        return n;
+    }
+
+    [[nodiscard]] EdgeIterator beginEdges(NodeHandle n) const {
+        return index_[nodeId(n)];
+    }
+
+    [[nodiscard]] EdgeIterator endEdges(NodeHandle n) const {
+        return index_[nodeId(n) + 1];
+    }
+
+    [[nodiscard]] NodeHandle edgeHead(EdgeIterator e) const {
+        return edges_[e];
+    }
+
+    [[nodiscard]] double edgeWeight(EdgeIterator e) const {
+        return weights_ != nullptr ? weights_[e] : 1.;
+    }
+
+private:
+    // checks that all edge ranges and heads stay within the arrays
+    void validateArrays(const std::string &file) const {
+        const Index *index = index_;
+        const NodeHandle *heads = edges_;
+        const std::size_t n = num_nodes_;
+        const std::size_t m = index_[num_nodes_];
+
+        bool monotone = true;
+        #pragma omp parallel for default(none) shared(index, n) reduction(&&: monotone) schedule(static)
+        for (std::size_t v = 0; v < n; ++v) {
+            monotone = monotone && index[v] <= index[v + 1];
+        }
+        if (!monotone) {
+            throw std::runtime_error(file + " has an index that is not monotone");
+        }
+
+        bool in_range = true;
+        #pragma omp parallel for default(none) shared(heads, n, m) reduction(&&: in_range) schedule(static)
+        for (std::size_t e = 0; e < m; ++e) {
+            in_range = in_range && heads[e] < n;
+        }
+        if (!in_range) {
+            throw std::runtime_error(file + " has an edge head out of range");
+        }
+    }
+
+    MappedFile file_;
+    std::size_t num_nodes_{0};
+    const Index *index_{nullptr};
+    const NodeHandle *edges_{nullptr};
+    const double *weights_{nullptr};
+};
+
+using MappedGraph = MappedGraphT<>;
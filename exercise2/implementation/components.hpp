@@ -0,0 +1,468 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "omp.h"
+
+// Weakly and strongly connected components, computed in parallel:
+/*
+  auto weak   = weakComponents(graph);    // weak.component[id], weak.num_components
+  auto strong = strongComponents(graph);  // numbered in topological order of the condensation
+
+  auto components = ComponentIndex(graph);
+  components.mayReach(s, t);              // false only if there is no path from s to t
+  helper.setComponents(&components);      // BFSHelper and DijkstraHelper answer such queries without a search
+*/
+// Weak components are found by a concurrent union-find, edges are linked in parallel with compare-and-swap. Strong
+// components follow the Multistep method [Slota et al. 2014]: nodes without in- or out-edges are trimmed, the component
+// of a pivot with high degree (usually the giant component) is the intersection of one forward and one backward search,
+// and the remaining nodes are split by coloring: every node takes the largest id that reaches it, and the component of a
+// node whose color is its own id consists of the nodes of that color that reach it. Once coloring makes little progress,
+// the remaining nodes are finished by sequential Tarjan.
+
+struct ComponentLabels {
+    // component of every node id, the components are numbered from 0
+    std::vector<std::size_t> component;
+    std::size_t num_components{0};
+};
+
+namespace components {
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    // out-edges and in-edges of a graph as arrays of node ids
+    struct Adjacency {
+        std::vector<std::size_t> out_index;
+        std::vector<std::size_t> out_head;
+        std::vector<std::size_t> in_index;
+        std::vector<std::size_t> in_head;
+    };
+
+    template<class GraphClass>
+    Adjacency adjacency(const GraphClass &graph) {
+        const auto n = graph.numNodes();
+        Adjacency adj;
+        adj.out_index.assign(n + 1, 0);
+        adj.in_index.assign(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                adj.out_index[u + 1]++;
+                adj.in_index[graph.nodeId(graph.edgeHead(e)) + 1]++;
+            }
+        }
+        std::partial_sum(adj.out_index.begin(), adj.out_index.end(), adj.out_index.begin());
+        std::partial_sum(adj.in_index.begin(), adj.in_index.end(), adj.in_index.begin());
+
+        adj.out_head.resize(adj.out_index[n]);
+        adj.in_head.resize(adj.in_index[n]);
+        std::vector<std::size_t> next_in(adj.in_index.begin(), adj.in_index.end() - 1);
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            auto k = adj.out_index[u];
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e, ++k) {
+                auto v = graph.nodeId(graph.edgeHead(e));
+                adj.out_head[k] = v;
+                adj.in_head[next_in[v]++] = u;
+            }
+        }
+        return adj;
+    }
+
+    // root of v with path halving, parents only ever decrease
+    inline std::size_t find(std::vector<std::size_t> &parent, std::size_t v) {
+        while (true) {
+            auto p = std::atomic_ref<std::size_t>(parent[v]).load(std::memory_order_relaxed);
+            auto grandparent = std::atomic_ref<std::size_t>(parent[p]).load(std::memory_order_relaxed);
+            if (p == grandparent) return p;
+            // a failed exchange only means that another thread shortened the path first
+            std::atomic_ref<std::size_t>(parent[v]).compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+            v = grandparent;
+        }
+    }
+
+    // links the larger root below the smaller one, retries if another thread linked one of the roots in between
+    inline void unite(std::vector<std::size_t> &parent, std::size_t u, std::size_t v) {
+        while (true) {
+            u = find(parent, u);
+            v = find(parent, v);
+            if (u == v) return;
+            if (u < v) std::swap(u, v);
+            auto expected = u;
+            if (std::atomic_ref<std::size_t>(parent[u]).compare_exchange_strong(expected, v,
+                                                                                std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    // numbers the representatives (nodes v with representative[v] == v) by increasing id
+    inline ComponentLabels relabel(const std::vector<std::size_t> &representative) {
+        const auto n = representative.size();
+        std::vector<std::size_t> id(n, 0);
+        std::size_t num_components = 0;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (representative[v] == v) id[v] = num_components++;
+        }
+        ComponentLabels labels{std::vector<std::size_t>(n), num_components};
+        #pragma omp parallel for default(none) shared(labels, id, representative, n) schedule(static)
+        for (std::size_t v = 0; v < n; ++v) {
+            labels.component[v] = id[representative[v]];
+        }
+        return labels;
+    }
+
+    /**
+     * Marks all nodes that are reachable from start over nodes with active(v) with the given value. Level synchronous,
+     * every level is searched in parallel and a node is claimed by the thread that sets its mark first.
+     */
+    template<class F>
+    void search(const std::vector<std::size_t> &index, const std::vector<std::size_t> &head, std::size_t start,
+                std::vector<uint8_t> &mark, uint8_t value, F active) {
+        std::vector<std::size_t> frontier{start}, next_frontier;
+        mark[start] |= value;
+        while (!frontier.empty()) {
+            next_frontier.clear();
+            #pragma omp parallel default(none) shared(index, head, mark, value, active, frontier, next_frontier)
+            {
+                std::vector<std::size_t> local;
+                #pragma omp for schedule(dynamic, 64) nowait
+                for (std::size_t i = 0; i < frontier.size(); ++i) {
+                    auto u = frontier[i];
+                    for (auto k = index[u]; k < index[u + 1]; ++k) {
+                        auto v = head[k];
+                        if (!active(v)) continue;
+                        std::atomic_ref<uint8_t> m(mark[v]);
+                        auto current = m.load(std::memory_order_relaxed);
+                        if ((current & value) == 0 && (m.fetch_or(value, std::memory_order_relaxed) & value) == 0) {
+                            local.push_back(v);
+                        }
+                    }
+                }
+                #pragma omp critical
+                next_frontier.insert(next_frontier.end(), local.begin(), local.end());
+            }
+            std::swap(frontier, next_frontier);
+        }
+    }
+
+    /**
+     * Tarjan's algorithm on the subgraph of the nodes with active(v), iterative. Sets the representative of every
+     * active node, which also makes it inactive. Edges into finished components are ignored like inactive nodes.
+     */
+    template<class F>
+    void tarjan(const Adjacency &adj, const std::vector<std::size_t> &nodes, std::vector<std::size_t> &representative,
+                F active) {
+        const auto n = representative.size();
+        std::vector<std::size_t> order(n, none), low(n, 0), stack;
+        // node and its next out-edge for every call on the recursion stack
+        std::vector<std::pair<std::size_t, std::size_t>> calls;
+        std::size_t next_order = 0;
+
+        auto visit = [&](std::size_t v) {
+            order[v] = low[v] = next_order++;
+            stack.push_back(v);
+            calls.emplace_back(v, adj.out_index[v]);
+        };
+
+        for (auto s: nodes) {
+            if (!active(s) || order[s] != none) continue;
+            visit(s);
+            while (!calls.empty()) {
+                auto [u, k] = calls.back();
+                if (k < adj.out_index[u + 1]) {
+                    calls.back().second++;
+                    auto v = adj.out_head[k];
+                    if (!active(v)) continue;
+                    if (order[v] == none) {
+                        visit(v);
+                    } else {
+                        // v is active and visited, so it is on the stack
+                        low[u] = std::min(low[u], order[v]);
+                    }
+                    continue;
+                }
+                calls.pop_back();
+                if (!calls.empty()) {
+                    auto parent = calls.back().first;
+                    low[parent] = std::min(low[parent], low[u]);
+                }
+                if (low[u] == order[u]) {
+                    std::size_t w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        representative[w] = u;
+                    } while (w != u);
+                }
+            }
+        }
+    }
+
+    /**
+     * Renumbers the components in topological order of the condensation, so every edge leads from a component to the
+     * same or a higher one (Kahn's algorithm).
+     */
+    inline void topologicalOrder(const Adjacency &adj, ComponentLabels &labels) {
+        const auto n = labels.component.size();
+        const auto k = labels.num_components;
+
+        std::vector<std::size_t> member_index(k + 1, 0), members(n);
+        for (auto c: labels.component) member_index[c + 1]++;
+        std::partial_sum(member_index.begin(), member_index.end(), member_index.begin());
+        std::vector<std::size_t> next(member_index.begin(), member_index.end() - 1);
+        for (std::size_t v = 0; v < n; ++v) members[next[labels.component[v]]++] = v;
+
+        std::vector<std::size_t> in_degree(k, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            for (auto e = adj.out_index[u]; e < adj.out_index[u + 1]; ++e) {
+                auto c_u = labels.component[u], c_v = labels.component[adj.out_head[e]];
+                if (c_u != c_v) in_degree[c_v]++;
+            }
+        }
+
+        std::vector<std::size_t> order;
+        order.reserve(k);
+        for (std::size_t c = 0; c < k; ++c) {
+            if (in_degree[c] == 0) order.push_back(c);
+        }
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            auto c = order[i];
+            for (auto j = member_index[c]; j < member_index[c + 1]; ++j) {
+                auto u = members[j];
+                for (auto e = adj.out_index[u]; e < adj.out_index[u + 1]; ++e) {
+                    auto c_v = labels.component[adj.out_head[e]];
+                    if (c_v != c && --in_degree[c_v] == 0) order.push_back(c_v);
+                }
+            }
+        }
+
+        std::vector<std::size_t> rank(k);
+        for (std::size_t i = 0; i < k; ++i) rank[order[i]] = i;
+        for (auto &c: labels.component) c = rank[c];
+    }
+}
+
+template<class GraphClass>
+ComponentLabels weakComponents(const GraphClass &graph) {
+    const auto n = graph.numNodes();
+    std::vector<std::size_t> parent(n), root(n);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    // find still compresses paths while the roots are collected, so they are written to a separate array
+    #pragma omp parallel default(none) shared(graph, parent, root, n)
+    {
+        #pragma omp for schedule(dynamic, 256)
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                components::unite(parent, u, graph.nodeId(graph.edgeHead(e)));
+            }
+        }
+
+        #pragma omp for schedule(static)
+        for (std::size_t v = 0; v < n; ++v) {
+            root[v] = components::find(parent, v);
+        }
+    }
+    return components::relabel(root);
+}
+
+/**
+ * Strongly connected components, numbered in topological order of the condensation: if there is a path from u to v,
+ * then component[u] <= component[v].
+ */
+template<class GraphClass>
+ComponentLabels strongComponents(const GraphClass &graph) {
+    using components::none;
+    const auto n = graph.numNodes();
+    const auto adj = components::adjacency(graph);
+
+    // representative of the component of every node, none while the node is active
+    std::vector<std::size_t> representative(n, none);
+    auto active = [&](std::size_t v) { return representative[v] == none; };
+
+    // trim nodes without active in- or out-neighbors, a few rounds catch most of them
+    std::vector<uint8_t> trimmed(n, 0);
+    for (int round = 0; round < 4; ++round) {
+        std::size_t num_trimmed = 0;
+        #pragma omp parallel default(none) shared(adj, representative, trimmed, n, active) reduction(+:num_trimmed)
+        {
+            #pragma omp for schedule(dynamic, 256)
+            for (std::size_t v = 0; v < n; ++v) {
+                if (!active(v)) continue;
+                auto has_neighbor = [&](const std::vector<std::size_t> &index, const std::vector<std::size_t> &head) {
+                    for (auto k = index[v]; k < index[v + 1]; ++k) {
+                        if (head[k] != v && active(head[k])) return true;
+                    }
+                    return false;
+                };
+                if (!has_neighbor(adj.out_index, adj.out_head) || !has_neighbor(adj.in_index, adj.in_head)) {
+                    trimmed[v] = 1;
+                    num_trimmed++;
+                }
+            }
+
+            #pragma omp for schedule(static)
+            for (std::size_t v = 0; v < n; ++v) {
+                if (trimmed[v]) {
+                    representative[v] = v;
+                    trimmed[v] = 0;
+                }
+            }
+        }
+        if (num_trimmed == 0) break;
+    }
+
+    // forward-backward search from the active node with the largest product of in- and out-degree
+    std::size_t pivot = none, best = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+        if (!active(v)) continue;
+        auto degree = (adj.out_index[v + 1] - adj.out_index[v]) * (adj.in_index[v + 1] - adj.in_index[v]);
+        if (pivot == none || degree > best) {
+            pivot = v;
+            best = degree;
+        }
+    }
+    if (pivot != none) {
+        std::vector<uint8_t> mark(n, 0);
+        components::search(adj.out_index, adj.out_head, pivot, mark, 1, active);
+        components::search(adj.in_index, adj.in_head, pivot, mark, 2, active);
+        #pragma omp parallel for default(none) shared(representative, mark, n, pivot) schedule(static)
+        for (std::size_t v = 0; v < n; ++v) {
+            if (mark[v] == 3) representative[v] = pivot;
+        }
+    }
+
+    // Coloring until all nodes belong to a component. Every round completes at least the component of the largest id,
+    // but on long paths of small components it may complete only one, and a color may increase once per level of the
+    // propagation. The remaining nodes are finished by sequential Tarjan when the propagation scans more than
+    // max_coloring_work times the active nodes, when a round completes less than 1% of them or after
+    // max_coloring_rounds rounds.
+    constexpr std::size_t max_coloring_rounds = 16;
+    constexpr std::size_t max_coloring_work = 8;
+    std::vector<std::size_t> active_nodes, color(n, 0);
+    std::vector<uint8_t> queued(n, 0);
+    for (std::size_t v = 0; v < n; ++v) {
+        if (active(v)) active_nodes.push_back(v);
+    }
+    for (std::size_t round = 0; !active_nodes.empty(); ++round) {
+        if (round == max_coloring_rounds) {
+            components::tarjan(adj, active_nodes, representative, active);
+            break;
+        }
+
+        for (auto v: active_nodes) color[v] = v;
+
+        // only nodes whose color increased in the last level have to push it on
+        std::vector<std::size_t> frontier(active_nodes), next_frontier;
+        std::size_t work = 0;
+        while (!frontier.empty() && work <= max_coloring_work * active_nodes.size()) {
+            work += frontier.size();
+            next_frontier.clear();
+            #pragma omp parallel default(none) shared(adj, color, active, queued, frontier, next_frontier)
+            {
+                std::vector<std::size_t> local;
+                #pragma omp for schedule(dynamic, 256) nowait
+                for (std::size_t i = 0; i < frontier.size(); ++i) {
+                    auto u = frontier[i];
+                    auto c_u = std::atomic_ref<std::size_t>(color[u]).load(std::memory_order_relaxed);
+                    for (auto k = adj.out_index[u]; k < adj.out_index[u + 1]; ++k) {
+                        auto v = adj.out_head[k];
+                        if (!active(v)) continue;
+                        std::atomic_ref<std::size_t> c_v(color[v]);
+                        auto current = c_v.load(std::memory_order_relaxed);
+                        while (current < c_u) {
+                            if (c_v.compare_exchange_weak(current, c_u, std::memory_order_relaxed)) {
+                                if (std::atomic_ref<uint8_t>(queued[v]).exchange(1, std::memory_order_relaxed) == 0) {
+                                    local.push_back(v);
+                                }
+                                break;
+                            }
+                        }
+                    }
+                }
+                #pragma omp critical
+                next_frontier.insert(next_frontier.end(), local.begin(), local.end());
+            }
+            for (auto v: next_frontier) queued[v] = 0;
+            std::swap(frontier, next_frontier);
+        }
+        if (!frontier.empty()) {
+            components::tarjan(adj, active_nodes, representative, active);
+            break;
+        }
+
+        // backward searches from the roots, inside their colors, are independent of each other
+        std::vector<std::size_t> roots;
+        for (auto v: active_nodes) {
+            if (color[v] == v) roots.push_back(v);
+        }
+        #pragma omp parallel default(none) shared(adj, color, representative, roots)
+        {
+            std::vector<std::size_t> stack;
+            #pragma omp for schedule(dynamic, 1)
+            for (std::size_t i = 0; i < roots.size(); ++i) {
+                auto root = roots[i];
+                representative[root] = root;
+                stack.assign(1, root);
+                while (!stack.empty()) {
+                    auto u = stack.back();
+                    stack.pop_back();
+                    for (auto k = adj.in_index[u]; k < adj.in_index[u + 1]; ++k) {
+                        auto v = adj.in_head[k];
+                        if (color[v] == root && representative[v] == none) {
+                            representative[v] = root;
+                            stack.push_back(v);
+                        }
+                    }
+                }
+            }
+        }
+
+        const auto num_active = active_nodes.size();
+        std::erase_if(active_nodes, [&](std::size_t v) { return !active(v); });
+        if ((num_active - active_nodes.size()) * 100 < num_active) {
+            components::tarjan(adj, active_nodes, representative, active);
+            break;
+        }
+    }
+
+    auto labels = components::relabel(representative);
+    components::topologicalOrder(adj, labels);
+    return labels;
+}
+
+
+/**
+ * Weak and strong components of a graph, answers whether a path between two nodes can exist.
+ */
+class ComponentIndex {
+public:
+    template<class GraphClass>
+    explicit ComponentIndex(const GraphClass &graph) : weak_(weakComponents(graph)), strong_(strongComponents(graph)) {}
+
+    [[nodiscard]] const ComponentLabels &weak() const {
+        return weak_;
+    }
+
+    [[nodiscard]] const ComponentLabels &strong() const {
+        return strong_;
+    }
+
+    // false only if there is no path from the node with id u to the node with id v
+    [[nodiscard]] bool mayReach(std::size_t u, std::size_t v) const {
+        auto s_u = strong_.component[u], s_v = strong_.component[v];
+        return s_u == s_v || (s_u < s_v && weak_.component[u] == weak_.component[v]);
+    }
+
+private:
+    ComponentLabels weak_;
+    ComponentLabels strong_;
+};
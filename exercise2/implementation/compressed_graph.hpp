@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "edge_list.hpp"
+
+
+/**
+ * Weighted adjacency array with compressed edge storage.
+ *
+ * The edges of every node are sorted by head and stored in one byte stream, each as a varint (LEB128) encoded delta
+ * followed by its weight. The first delta of a node is relative to the node itself, every further delta is relative to
+ * the previous neighbor. Deltas are zigzag encoded, so the first (possibly negative) delta does not need special
+ * treatment while decoding. Besides the byte stream only one byte offset per node is stored, edges are never addressed
+ * by id.
+ *
+ * If all weights are integers below 2^53 they are stored unscaled as varints and are exact. Otherwise they are
+ * quantized to 32 bit fixed point values with a common scale, such that the largest weight maps to the largest
+ * representable value. The error of every such weight is then at most max_weight / (2 * (2^32 - 1)).
+ *
+ * For graphs with locality in their node ids (e.g. road networks) most deltas fit into one or two bytes.
+ */
+template<class Index = uint64_t>
+class CompressedWeightedGraphT {
+public:
+    using NodeHandle = Index;
+    using Weight = std::uint32_t;
+
+    class EdgeIterator {
+    public:
+        EdgeIterator() = default;
+
+        EdgeIterator &operator++() {
+            previous_ = decodeHead(position_, previous_);
+            skipWeight(position_, fixed_weights_);
+            return *this;
+        }
+
+        [[nodiscard]] bool operator==(const EdgeIterator &other) const { return position_ == other.position_; }
+
+        [[nodiscard]] bool operator!=(const EdgeIterator &other) const { return position_ != other.position_; }
+
+        [[nodiscard]] bool operator<(const EdgeIterator &other) const { return position_ < other.position_; }
+
+    private:
+        friend class CompressedWeightedGraphT;
+
+        EdgeIterator(const std::uint8_t *position, Index previous, bool fixed_weights)
+                : position_(position), previous_(previous), fixed_weights_(fixed_weights) {}
+
+        const std::uint8_t *position_{nullptr};
+        Index previous_{0};
+        bool fixed_weights_{false};
+    };
+
+    explicit CompressedWeightedGraphT(std::size_t num_nodes = 0, const EdgeList &edges = {})
+            : byte_index_(num_nodes + 1) {
+        if (num_nodes > static_cast<std::size_t>(std::numeric_limits<Index>::max()) ||
+            edges.size() > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+
+        constexpr double max_integral_weight = 9007199254740992.0; // 2^53
+        double max_weight = 0.0;
+        bool sorted = true;
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            const auto &e = edges[i];
+            if (e.length < 0.0) {
+                throw std::runtime_error("negative edge weight");
+            }
+            if (e.from >= num_nodes || e.to >= num_nodes) {
+                throw std::runtime_error("edge endpoint out of range");
+            }
+            max_weight = std::max(max_weight, e.length);
+            fixed_weights_ = fixed_weights_ || e.length != std::floor(e.length) || e.length >= max_integral_weight;
+            if (i > 0 && std::make_pair(edges[i - 1].from, edges[i - 1].to) > std::make_pair(e.from, e.to)) {
+                sorted = false;
+            }
+        }
+        if (fixed_weights_ && max_weight > 0.0) {
+            weight_scale_ = max_weight / std::numeric_limits<Weight>::max();
+        }
+
+        // Edge ids grouped by tail and sorted by head. Not needed if the edge list is already sorted, which is the
+        // case for most graph files, so then the edges are encoded without any copy.
+        std::vector<Index> order;
+        if (!sorted) {
+            std::vector<Index> c(num_nodes + 1, 0);
+            for (const auto &e: edges) c[e.from + 1]++;
+            std::inclusive_scan(c.begin(), c.end(), c.begin());
+            order.resize(edges.size());
+            for (std::size_t i = 0; i < edges.size(); ++i) {
+                order[c[edges[i].from]++] = static_cast<Index>(i);
+            }
+            // c[u] is now the end of the edges of u
+            for (std::size_t u = 0; u < num_nodes; ++u) {
+                auto begin = order.begin() + (u == 0 ? 0 : c[u - 1]);
+                auto end = order.begin() + c[u];
+                std::sort(begin, end, [&](Index a, Index b) { return edges[a].to < edges[b].to; });
+            }
+        }
+        auto edge = [&](std::size_t i) -> const Edge & { return edges[sorted ? i : order[i]]; };
+
+        bytes_.reserve(edges.size() * (fixed_weights_ ? 6 : 3));
+        std::size_t i = 0;
+        for (std::size_t u = 0; u < num_nodes; ++u) {
+            byte_index_[u] = bytes_.size();
+            auto previous = static_cast<std::int64_t>(u);
+            for (; i < edges.size() && edge(i).from == u; ++i) {
+                auto head = static_cast<std::int64_t>(edge(i).to);
+                encode((static_cast<std::uint64_t>(head - previous) << 1) ^
+                       static_cast<std::uint64_t>((head - previous) >> 63));
+                previous = head;
+                encodeWeight(edge(i).length);
+            }
+        }
+        assert(i == edges.size());
+        byte_index_[num_nodes] = bytes_.size();
+        bytes_.shrink_to_fit();
+    }
+
+    [[nodiscard]] std::size_t numNodes() const {
+        return byte_index_.size() - 1;
+    };
+
+    [[nodiscard]] NodeHandle node(std::size_t n) const {
+        return n;
+    }
+
+    [[nodiscard]] std::size_t nodeId(NodeHandle n) const {
+        return n;
+    }
+
+    [[nodiscard]] EdgeIterator beginEdges(NodeHandle n) const {
+        auto id = nodeId(n);
+        return {bytes_.data() + byte_index_[id], n, fixed_weights_};
+    }
+
+    [[nodiscard]] EdgeIterator endEdges(NodeHandle n) const {
+        auto id = nodeId(n);
+        return {bytes_.data() + byte_index_[id + 1], n, fixed_weights_};
+    }
+
+    [[nodiscard]] NodeHandle edgeHead(EdgeIterator e) const {
+        return decodeHead(e.position_, e.previous_);
+    }
+
+    [[nodiscard]] double edgeWeight(EdgeIterator e) const {
+        auto position = e.position_;
+        decode(position);
+        if (!fixed_weights_) {
+            return static_cast<double>(decode(position));
+        }
+        Weight weight;
+        std::memcpy(&weight, position, sizeof(Weight));
+        return weight * weight_scale_;
+    }
+
+    /**
+     * Returns the number of bytes used for the edge storage (neighbors and weights).
+     */
+    [[nodiscard]] std::size_t edgeBytes() const {
+        return bytes_.size();
+    }
+
+    /**
+     * Returns true if the weights are quantized to fixed point values, false if they are stored exactly.
+     */
+    [[nodiscard]] bool fixedPointWeights() const {
+        return fixed_weights_;
+    }
+
+private:
+    std::vector<std::uint64_t> byte_index_;
+    std::vector<std::uint8_t> bytes_;
+    bool fixed_weights_{false};
+    double weight_scale_{1.0};
+
+    // decodes the varint at position, position is advanced past it
+    static std::uint64_t decode(const std::uint8_t *&position) {
+        std::uint64_t value = 0;
+        unsigned shift = 0;
+        std::uint8_t byte;
+        do {
+            byte = *position++;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+    // decodes the delta at position and returns the neighbor it encodes relative to previous
+    static Index decodeHead(const std::uint8_t *&position, Index previous) {
+        auto value = decode(position);
+        auto delta = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        return static_cast<Index>(static_cast<std::int64_t>(previous) + delta);
+    }
+
+    static void skipWeight(const std::uint8_t *&position, bool fixed_weights) {
+        if (fixed_weights) {
+            position += sizeof(Weight);
+        } else {
+            while (*position++ & 0x80) {}
+        }
+    }
+
+    void encode(std::uint64_t value) {
+        while (value >= 0x80) {
+            bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes_.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void encodeWeight(double weight) {
+        if (!fixed_weights_) {
+            encode(static_cast<std::uint64_t>(weight));
+            return;
+        }
+        auto quantized = static_cast<Weight>(std::llround(weight / weight_scale_));
+        std::uint8_t buffer[sizeof(Weight)];
+        std::memcpy(buffer, &quantized, sizeof(Weight));
+        bytes_.insert(bytes_.end(), buffer, buffer + sizeof(Weight));
+    }
+};
+
+using CompressedWeightedGraph = CompressedWeightedGraphT<>;
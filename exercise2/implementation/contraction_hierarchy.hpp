@@ -0,0 +1,414 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "edge_list.hpp"
+#include "indexed_priority_queue.hpp"
+#include "weighted_graph_separated.hpp"
+
+// Contraction Hierarchies [Geisberger et al. 2008]. The hierarchy is built by the constructor and queried with a helper:
+/*
+  auto ch       = ContractionHierarchy(num_nodes, edges);
+  auto helper   = ContractionHierarchyHelper<ContractionHierarchy>(ch);
+  auto distance = helper.dijkstra(ch.node(1), ch.node(2));
+*/
+// Nodes are contracted in the order of their edge difference (number of added shortcuts minus number of removed edges)
+// plus the number of already contracted neighbors. Priorities are updated lazily when a node is taken from the queue and
+// for the neighbors of every contracted node. Witness searches are limited to witness_settle_limit settled nodes, which
+// may add unnecessary shortcuts, but never misses a necessary one.
+
+namespace contraction_hierarchy {
+    struct Arc {
+        std::size_t node;
+        double weight;
+    };
+
+    class Contractor {
+    public:
+        static constexpr std::size_t witness_settle_limit = 500;
+
+        Contractor(std::size_t num_nodes, const EdgeList &edges)
+                : out_(num_nodes), in_(num_nodes), contracted_neighbors_(num_nodes),
+                  distance_(num_nodes, std::numeric_limits<double>::infinity()), is_target_(num_nodes),
+                  position_(num_nodes, no_position) {
+            witness_queue_.reserve(num_nodes);
+            std::vector<Edge> initial;
+            initial.reserve(edges.size());
+            std::copy_if(edges.begin(), edges.end(), std::back_inserter(initial),
+                         [](const Edge &e) { return e.from != e.to; });
+            insert(initial);
+        }
+
+        /**
+         * Contracts all nodes and writes the rank of every node. Returns the upward edges (u, v) with rank(u) < rank(v)
+         * and the downward edges reversed, i.e. (v, u) for every edge (u, v) with rank(u) > rank(v).
+         */
+        template<class Index>
+        std::pair<EdgeList, EdgeList> run(std::vector<Index> &rank) {
+            const auto num_nodes = out_.size();
+
+            IndexedPriorityQueue<std::size_t, std::ptrdiff_t, std::greater<>> queue(num_nodes);
+            for (std::size_t v = 0; v < num_nodes; ++v) {
+                queue.push(v, priority(v));
+            }
+
+            EdgeList up, down;
+            Index next_rank = 0;
+            while (!queue.empty()) {
+                auto [v, old_priority] = queue.top();
+                auto new_priority = priority(v);
+                if (new_priority > old_priority) {
+                    queue.changePriority(v, new_priority);
+                    continue;
+                }
+                queue.pop();
+
+                // shortcuts_ still holds the shortcuts of v from the priority computation
+                contract(v, up, down);
+                rank[v] = next_rank++;
+
+                for (auto u: neighbors_) {
+                    queue.changePriority(u, priority(u));
+                }
+            }
+            return {std::move(up), std::move(down)};
+        }
+
+    private:
+        // adjacency lists of the remaining graph, they only contain uncontracted nodes
+        std::vector<std::vector<Arc>> out_;
+        std::vector<std::vector<Arc>> in_;
+        std::vector<std::ptrdiff_t> contracted_neighbors_;
+
+        std::vector<Edge> shortcuts_{};
+        std::vector<std::size_t> neighbors_{};
+
+        std::vector<double> distance_;
+        std::vector<bool> is_target_;
+        // position of a node in the adjacency list that is currently merged, no_position otherwise
+        static constexpr std::size_t no_position = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> position_;
+        std::vector<std::size_t> touched_{};
+        IndexedPriorityQueue<std::size_t, double, std::greater<>> witness_queue_;
+
+        // merges the arcs into arcs, an arc to a node that is already present only decreases its weight
+        template<class It, class F>
+        void merge(std::vector<Arc> &arcs, It begin, It end, F other) {
+            for (std::size_t i = 0; i < arcs.size(); ++i) {
+                position_[arcs[i].node] = i;
+            }
+            for (auto it = begin; it != end; ++it) {
+                auto node = other(*it);
+                if (position_[node] == no_position) {
+                    position_[node] = arcs.size();
+                    arcs.push_back({node, it->length});
+                } else {
+                    auto &weight = arcs[position_[node]].weight;
+                    weight = std::min(weight, it->length);
+                }
+            }
+            for (const auto &arc: arcs) {
+                position_[arc.node] = no_position;
+            }
+        }
+
+        // Inserts the edges or decreases their weights, parallel edges are merged. The edges are grouped by tail and
+        // by head, so every adjacency list is scanned once per call instead of once per edge. Reorders edges.
+        void insert(std::vector<Edge> &edges) {
+            auto by_tail = [](const Edge &a, const Edge &b) { return a.from < b.from; };
+            auto by_head = [](const Edge &a, const Edge &b) { return a.to < b.to; };
+
+            std::sort(edges.begin(), edges.end(), by_tail);
+            for (auto begin = edges.begin(); begin != edges.end();) {
+                auto end = std::upper_bound(begin, edges.end(), *begin, by_tail);
+                merge(out_[begin->from], begin, end, [](const Edge &e) { return e.to; });
+                begin = end;
+            }
+
+            std::sort(edges.begin(), edges.end(), by_head);
+            for (auto begin = edges.begin(); begin != edges.end();) {
+                auto end = std::upper_bound(begin, edges.end(), *begin, by_head);
+                merge(in_[begin->to], begin, end, [](const Edge &e) { return e.from; });
+                begin = end;
+            }
+        }
+
+        static void erase(std::vector<Arc> &arcs, std::size_t v) {
+            auto it = std::find_if(arcs.begin(), arcs.end(), [v](const Arc &a) { return a.node == v; });
+            *it = arcs.back();
+            arcs.pop_back();
+        }
+
+        // Dijkstra from source in the remaining graph without excluded, stops once num_targets marked targets are
+        // settled, at max_distance or after witness_settle_limit settled nodes. The distances stay valid until
+        // resetWitnessSearch.
+        void witnessSearch(std::size_t source, std::size_t excluded, double max_distance, std::size_t num_targets) {
+            distance_[source] = 0.0;
+            touched_.push_back(source);
+            witness_queue_.push(source, 0.0);
+
+            std::size_t settled = 0;
+            while (!witness_queue_.empty() && settled < witness_settle_limit) {
+                auto [u, d_u] = witness_queue_.pop();
+                if (d_u > max_distance) break;
+                settled++;
+                if (is_target_[u] && --num_targets == 0) break;
+
+                for (auto [v, w]: out_[u]) {
+                    if (v == excluded) continue;
+                    if (d_u + w < distance_[v]) {
+                        if (distance_[v] == std::numeric_limits<double>::infinity()) {
+                            touched_.push_back(v);
+                        }
+                        distance_[v] = d_u + w;
+                        witness_queue_.pushOrChangePriority(v, d_u + w);
+                    }
+                }
+            }
+        }
+
+        void resetWitnessSearch() {
+            for (auto u: touched_) {
+                distance_[u] = std::numeric_limits<double>::infinity();
+            }
+            touched_.clear();
+            witness_queue_.clear();
+        }
+
+        // collects the shortcuts needed to contract v into shortcuts_
+        void findShortcuts(std::size_t v) {
+            shortcuts_.clear();
+            for (auto [u, w_uv]: in_[v]) {
+                double max_distance = 0.0;
+                std::size_t num_targets = 0;
+                for (auto [x, w_vx]: out_[v]) {
+                    if (x == u) continue;
+                    max_distance = std::max(max_distance, w_uv + w_vx);
+                    is_target_[x] = true;
+                    num_targets++;
+                }
+                if (num_targets == 0) continue;
+
+                witnessSearch(u, v, max_distance, num_targets);
+                for (auto [x, w_vx]: out_[v]) {
+                    if (x != u && w_uv + w_vx < distance_[x]) {
+                        shortcuts_.push_back({u, x, w_uv + w_vx});
+                    }
+                    is_target_[x] = false;
+                }
+                resetWitnessSearch();
+            }
+        }
+
+        std::ptrdiff_t priority(std::size_t v) {
+            findShortcuts(v);
+            auto edge_difference = static_cast<std::ptrdiff_t>(shortcuts_.size()) -
+                                   static_cast<std::ptrdiff_t>(in_[v].size() + out_[v].size());
+            return edge_difference + contracted_neighbors_[v];
+        }
+
+        void contract(std::size_t v, EdgeList &up, EdgeList &down) {
+            neighbors_.clear();
+            for (auto [x, w]: out_[v]) {
+                up.push_back({v, x, w});
+                erase(in_[x], v);
+                neighbors_.push_back(x);
+            }
+            for (auto [u, w]: in_[v]) {
+                down.push_back({v, u, w});
+                erase(out_[u], v);
+                neighbors_.push_back(u);
+            }
+            std::vector<Arc>().swap(out_[v]);
+            std::vector<Arc>().swap(in_[v]);
+
+            std::sort(neighbors_.begin(), neighbors_.end());
+            neighbors_.erase(std::unique(neighbors_.begin(), neighbors_.end()), neighbors_.end());
+            for (auto u: neighbors_) {
+                contracted_neighbors_[u]++;
+            }
+
+            insert(shortcuts_);
+        }
+    };
+}
+
+template<class Index = uint64_t>
+class ContractionHierarchyT {
+public:
+    using NodeHandle = Index;
+    using SearchGraph = WeightedGraphSeparatedT<Index>;
+
+    explicit ContractionHierarchyT(std::size_t num_nodes = 0, const EdgeList &edges = {}) : rank_(num_nodes) {
+        contraction_hierarchy::Contractor contractor(num_nodes, edges);
+        auto [up, down] = contractor.run(rank_);
+        num_edges_ = up.size() + down.size();
+        upward_ = SearchGraph(num_nodes, up);
+        downward_ = SearchGraph(num_nodes, down);
+    }
+
+    [[nodiscard]] std::size_t numNodes() const {
+        return rank_.size();
+    }
+
+    [[nodiscard]] NodeHandle node(std::size_t n) const {
+        return n;
+    }
+
+    [[nodiscard]] std::size_t nodeId(NodeHandle n) const {
+        return n;
+    }
+
+    // position of the node in the contraction order
+    [[nodiscard]] std::size_t rank(NodeHandle n) const {
+        return rank_[nodeId(n)];
+    }
+
+    // number of edges in the hierarchy, including shortcuts
+    [[nodiscard]] std::size_t numEdges() const {
+        return num_edges_;
+    }
+
+    // edges (u, v) with rank(u) < rank(v)
+    [[nodiscard]] const SearchGraph &upwardGraph() const {
+        return upward_;
+    }
+
+    // edges (u, v) with rank(u) > rank(v), stored as (v, u) for the backward search
+    [[nodiscard]] const SearchGraph &downwardGraph() const {
+        return downward_;
+    }
+
+private:
+    std::vector<Index> rank_;
+    std::size_t num_edges_{0};
+    SearchGraph upward_;
+    SearchGraph downward_;
+};
+
+using ContractionHierarchy = ContractionHierarchyT<>;
+
+
+// Bidirectional Dijkstra on the upward graph from start and on the downward graph from end. A search direction stops once
+// its queue minimum reaches the shortest path found so far. Only touched nodes are reset after a query.
+template<class CHClass>
+class ContractionHierarchyHelper {
+private:
+    using NodeHandle = typename CHClass::NodeHandle;
+    using SearchGraph = typename CHClass::SearchGraph;
+    using Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>;
+
+    static constexpr auto infty = std::numeric_limits<double>::infinity();
+
+    const CHClass &ch;
+
+    std::vector<double> forward_distance;
+    std::vector<double> backward_distance;
+    std::vector<std::size_t> touched{};
+    std::vector<std::pair<std::size_t, double>> search_space{};
+    Queue forward_queue;
+    Queue backward_queue;
+
+    void relax(Queue &queue, std::vector<double> &distance, std::size_t v_id, double d_v) {
+        if (d_v < distance[v_id]) {
+            if (distance[v_id] == infty) {
+                // nodes reached in both directions are reset twice
+                touched.push_back(v_id);
+            }
+            distance[v_id] = d_v;
+            queue.pushOrChangePriority(v_id, d_v);
+        }
+    }
+
+    double settle(const SearchGraph &g, Queue &queue, std::vector<double> &distance,
+                  const std::vector<double> &other_distance) {
+        auto [u_id, d_u] = queue.pop();
+        auto u = g.node(u_id);
+        for (auto e = g.beginEdges(u); e < g.endEdges(u); ++e) {
+            relax(queue, distance, g.nodeId(g.edgeHead(e)), d_u + g.edgeWeight(e));
+        }
+        return d_u + other_distance[u_id];
+    }
+
+    void reset() {
+        for (auto u: touched) {
+            forward_distance[u] = infty;
+            backward_distance[u] = infty;
+        }
+        touched.clear();
+        forward_queue.clear();
+        backward_queue.clear();
+    }
+
+    const std::vector<std::pair<std::size_t, double>> &
+    searchSpace(const SearchGraph &g, Queue &queue, std::vector<double> &distance, NodeHandle source) {
+        search_space.clear();
+        relax(queue, distance, ch.nodeId(source), 0.0);
+        while (!queue.empty()) {
+            auto [u_id, d_u] = queue.pop();
+            search_space.emplace_back(u_id, d_u);
+            auto u = g.node(u_id);
+            for (auto e = g.beginEdges(u); e < g.endEdges(u); ++e) {
+                relax(queue, distance, g.nodeId(g.edgeHead(e)), d_u + g.edgeWeight(e));
+            }
+        }
+        reset();
+        return search_space;
+    }
+
+public:
+    explicit ContractionHierarchyHelper(const CHClass &ch)
+            : ch(ch), forward_distance(ch.numNodes(), infty), backward_distance(ch.numNodes(), infty) {
+        forward_queue.reserve(ch.numNodes());
+        backward_queue.reserve(ch.numNodes());
+    }
+
+    double dijkstra(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0.0;
+        }
+
+        relax(forward_queue, forward_distance, ch.nodeId(start), 0.0);
+        relax(backward_queue, backward_distance, ch.nodeId(end), 0.0);
+
+        double shortest = infty;
+        while (true) {
+            bool forward = !forward_queue.empty() && forward_queue.top().second < shortest;
+            bool backward = !backward_queue.empty() && backward_queue.top().second < shortest;
+            if (forward && backward) {
+                forward = forward_queue.top().second <= backward_queue.top().second;
+            } else if (!forward && !backward) {
+                break;
+            }
+
+            if (forward) {
+                shortest = std::min(shortest, settle(ch.upwardGraph(), forward_queue, forward_distance,
+                                                     backward_distance));
+            } else {
+                shortest = std::min(shortest, settle(ch.downwardGraph(), backward_queue, backward_distance,
+                                                     forward_distance));
+            }
+        }
+
+        reset();
+        return shortest;
+    }
+
+    // Runs the complete upward search from start and returns all settled nodes with their distance. The reference is
+    // valid until the next query.
+    const std::vector<std::pair<std::size_t, double>> &forwardSearchSpace(NodeHandle start) {
+        return searchSpace(ch.upwardGraph(), forward_queue, forward_distance, start);
+    }
+
+    // Same as forwardSearchSpace, but on the downward graph, i.e. the distances are from the nodes to end.
+    const std::vector<std::pair<std::size_t, double>> &backwardSearchSpace(NodeHandle end) {
+        return searchSpace(ch.downwardGraph(), backward_queue, backward_distance, end);
+    }
+};
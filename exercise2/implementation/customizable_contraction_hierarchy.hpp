@@ -0,0 +1,366 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "omp.h"
+
+#include "edge_list.hpp"
+#include "partition.hpp"
+#include "reordering.hpp"
+
+// Customizable Contraction Hierarchies [Dibbelt et al. 2016]. The preprocessing is split into a metric independent
+// phase, which only depends on the structure of the graph, and a customization, which computes the weights:
+/*
+  auto cch      = CustomizableContractionHierarchy(graph);  // any weighted graph, e.g. WeightedGraphSeparated
+  auto helper   = CustomizableContractionHierarchyHelper<CustomizableContractionHierarchy>(cch);
+  auto distance = helper.dijkstra(cch.node(1), cch.node(2));
+
+  graph.updateWeights(updates);  // same structure, new weights
+  cch.customize(graph);
+*/
+// The nodes are ordered by nested dissection and contracted without witness searches, so the upward arcs form a chordal
+// supergraph of the input. The customization runs in parallel, one level of the elimination tree after the other.
+
+namespace customizable_contraction_hierarchy {
+    template<class WeightedGraphClass>
+    EdgeList edgeList(const WeightedGraphClass &graph) {
+        EdgeList edges;
+        for (std::size_t u = 0; u < graph.numNodes(); ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                edges.push_back({u, graph.nodeId(graph.edgeHead(e)), graph.edgeWeight(e)});
+            }
+        }
+        return edges;
+    }
+
+    template<class WeightedGraphClass>
+    std::size_t degree(const WeightedGraphClass &graph, std::size_t u) {
+        auto handle = graph.node(u);
+        return static_cast<std::size_t>(graph.endEdges(handle) - graph.beginEdges(handle));
+    }
+}
+
+template<class Index = uint64_t>
+class CustomizableContractionHierarchyT {
+public:
+    using NodeHandle = Index;
+
+    /**
+     * Orders the nodes by nested dissection, builds the hierarchy and customizes it with the weights of the graph.
+     */
+    template<class WeightedGraphClass>
+    explicit CustomizableContractionHierarchyT(const WeightedGraphClass &graph)
+            : CustomizableContractionHierarchyT(graph, nestedDissectionOrdering(
+            graph.numNodes(), customizable_contraction_hierarchy::edgeList(graph))) {}
+
+    /**
+     * Builds the hierarchy for the given contraction order, the node with new id i is contracted i-th.
+     */
+    template<class WeightedGraphClass>
+    CustomizableContractionHierarchyT(const WeightedGraphClass &graph, const NodeOrdering &ordering)
+            : rank_(graph.numNodes()), input_offset_(graph.numNodes() + 1, 0) {
+        const auto n = graph.numNodes();
+        if (n > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+        if (ordering.size() != n) {
+            throw std::runtime_error("ordering does not match the graph");
+        }
+        for (std::size_t v = 0; v < n; ++v) {
+            rank_[v] = static_cast<Index>(ordering.toNew(v));
+        }
+
+        // upper neighbors by rank, eliminating a node makes its upper neighbors adjacent to each other
+        std::vector<std::vector<Index>> upper(n);
+        std::size_t num_input_edges = 0;
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                auto v = graph.nodeId(graph.edgeHead(e));
+                if (u != v) {
+                    upper[std::min(rank_[u], rank_[v])].push_back(std::max(rank_[u], rank_[v]));
+                }
+            }
+            num_input_edges += customizable_contraction_hierarchy::degree(graph, u);
+            input_offset_[u + 1] = static_cast<Index>(num_input_edges);
+        }
+        if (num_input_edges > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+
+        parent_.assign(n, static_cast<Index>(n));
+        up_index_.assign(n + 1, 0);
+        for (std::size_t r = 0; r < n; ++r) {
+            auto &arcs = upper[r];
+            std::sort(arcs.begin(), arcs.end());
+            arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+            if (!arcs.empty()) {
+                parent_[r] = arcs[0];
+                upper[arcs[0]].insert(upper[arcs[0]].end(), arcs.begin() + 1, arcs.end());
+            }
+            up_index_[r + 1] = up_index_[r] + static_cast<Index>(arcs.size());
+            up_head_.insert(up_head_.end(), arcs.begin(), arcs.end());
+            std::vector<Index>().swap(arcs);
+        }
+        if (up_head_.size() >= static_cast<std::size_t>(no_arc)) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+        up_weight_.resize(up_head_.size());
+        down_weight_.resize(up_head_.size());
+
+        // lower neighbors by rank together with the arc from the lower neighbor
+        down_index_.assign(n + 1, 0);
+        for (auto h: up_head_) down_index_[h + 1]++;
+        std::inclusive_scan(down_index_.begin(), down_index_.end(), down_index_.begin());
+        down_tail_.resize(up_head_.size());
+        down_arc_.resize(up_head_.size());
+        {
+            auto position = down_index_;
+            for (std::size_t r = 0; r < n; ++r) {
+                for (auto a = up_index_[r]; a < up_index_[r + 1]; ++a) {
+                    auto k = position[up_head_[a]]++;
+                    down_tail_[k] = static_cast<Index>(r);
+                    down_arc_[k] = a;
+                }
+            }
+        }
+
+        // group the nodes by their height in the elimination tree, all lower neighbors of a node are its descendants
+        std::vector<Index> height(n, 0);
+        for (std::size_t r = 0; r < n; ++r) {
+            if (parent_[r] != n) height[parent_[r]] = std::max<Index>(height[parent_[r]], height[r] + 1);
+        }
+        level_index_.assign((n == 0 ? 0 : *std::max_element(height.begin(), height.end()) + 1) + 1, 0);
+        for (auto h: height) level_index_[h + 1]++;
+        std::inclusive_scan(level_index_.begin(), level_index_.end(), level_index_.begin());
+        level_nodes_.resize(n);
+        {
+            auto position = level_index_;
+            for (std::size_t r = 0; r < n; ++r) {
+                level_nodes_[position[height[r]]++] = static_cast<Index>(r);
+            }
+        }
+
+        // arc and direction of every input edge
+        input_arc_.resize(input_offset_[n]);
+        input_upward_.resize(input_offset_[n]);
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            auto k = input_offset_[u];
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e, ++k) {
+                auto v = graph.nodeId(graph.edgeHead(e));
+                if (u == v) {
+                    input_arc_[k] = no_arc;
+                    continue;
+                }
+                auto low = std::min(rank_[u], rank_[v]), high = std::max(rank_[u], rank_[v]);
+                auto it = std::lower_bound(up_head_.begin() + up_index_[low], up_head_.begin() + up_index_[low + 1], high);
+                input_arc_[k] = static_cast<Index>(it - up_head_.begin());
+                input_upward_[k] = rank_[u] < rank_[v];
+            }
+        }
+
+        customize(graph);
+    }
+
+    /**
+     * Recomputes all weights from the edge weights of the graph. The graph must have the same edges in the same order
+     * as the graph the hierarchy was built for, only the weights may differ.
+     */
+    template<class WeightedGraphClass>
+    void customize(const WeightedGraphClass &graph) {
+        const auto n = numNodes();
+
+        if (graph.numNodes() != n) {
+            throw std::runtime_error("graph does not match the hierarchy");
+        }
+        for (std::size_t u = 0; u < n; ++u) {
+            if (customizable_contraction_hierarchy::degree(graph, u) != input_offset_[u + 1] - input_offset_[u]) {
+                throw std::runtime_error("graph does not match the hierarchy");
+            }
+        }
+
+        #pragma omp parallel default(none) shared(graph, n)
+        {
+            #pragma omp for schedule(static)
+            for (std::size_t a = 0; a < up_head_.size(); ++a) {
+                up_weight_[a] = std::numeric_limits<double>::infinity();
+                down_weight_[a] = std::numeric_limits<double>::infinity();
+            }
+
+            // every (arc, direction) is only written by the edges of one input node
+            #pragma omp for schedule(dynamic, 256)
+            for (std::size_t u = 0; u < n; ++u) {
+                auto handle = graph.node(u);
+                auto k = input_offset_[u];
+                for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e, ++k) {
+                    if (input_arc_[k] == no_arc) continue;
+                    auto &w = input_upward_[k] ? up_weight_[input_arc_[k]] : down_weight_[input_arc_[k]];
+                    w = std::min(w, graph.edgeWeight(e));
+                }
+            }
+
+            // lower triangles: the arcs of v are only written while v is processed and only read afterwards
+            std::vector<Index> slot(n);
+            for (std::size_t l = 0; l + 1 < level_index_.size(); ++l) {
+                #pragma omp for schedule(dynamic, 64)
+                for (auto i = level_index_[l]; i < level_index_[l + 1]; ++i) {
+                    auto v = level_nodes_[i];
+                    for (auto a = up_index_[v]; a < up_index_[v + 1]; ++a) {
+                        slot[up_head_[a]] = a;
+                    }
+                    for (auto k = down_index_[v]; k < down_index_[v + 1]; ++k) {
+                        auto u = down_tail_[k];
+                        auto a_uv = down_arc_[k];
+                        // the heads are sorted, so the arcs after (u, v) lead to upper neighbors w of v
+                        for (auto a_uw = a_uv + 1; a_uw < up_index_[u + 1]; ++a_uw) {
+                            auto a_vw = slot[up_head_[a_uw]];
+                            up_weight_[a_vw] = std::min(up_weight_[a_vw], down_weight_[a_uv] + up_weight_[a_uw]);
+                            down_weight_[a_vw] = std::min(down_weight_[a_vw], down_weight_[a_uw] + up_weight_[a_uv]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t numNodes() const {
+        return rank_.size();
+    }
+
+    [[nodiscard]] NodeHandle node(std::size_t n) const {
+        return n;
+    }
+
+    [[nodiscard]] std::size_t nodeId(NodeHandle n) const {
+        return n;
+    }
+
+    // position of the node in the contraction order
+    [[nodiscard]] std::size_t rank(NodeHandle n) const {
+        return rank_[nodeId(n)];
+    }
+
+    // number of upward arcs, every arc has a weight in both directions
+    [[nodiscard]] std::size_t numArcs() const {
+        return up_head_.size();
+    }
+
+    // parent of the node with the given rank in the elimination tree, numNodes() for a root
+    [[nodiscard]] std::size_t parent(std::size_t r) const {
+        return parent_[r];
+    }
+
+    // upward arcs of the node with the given rank
+    [[nodiscard]] std::size_t beginArcs(std::size_t r) const {
+        return up_index_[r];
+    }
+
+    [[nodiscard]] std::size_t endArcs(std::size_t r) const {
+        return up_index_[r + 1];
+    }
+
+    // rank of the upper end of the arc
+    [[nodiscard]] std::size_t arcHead(std::size_t a) const {
+        return up_head_[a];
+    }
+
+    // weight from the lower to the upper end of the arc
+    [[nodiscard]] double upWeight(std::size_t a) const {
+        return up_weight_[a];
+    }
+
+    // weight from the upper to the lower end of the arc
+    [[nodiscard]] double downWeight(std::size_t a) const {
+        return down_weight_[a];
+    }
+
+private:
+    static constexpr auto no_arc = std::numeric_limits<Index>::max();
+
+    std::vector<Index> rank_;
+    std::vector<Index> parent_{};
+
+    std::vector<Index> up_index_{};
+    std::vector<Index> up_head_{};
+    std::vector<double> up_weight_{};
+    std::vector<double> down_weight_{};
+
+    std::vector<Index> down_index_{};
+    std::vector<Index> down_tail_{};
+    std::vector<Index> down_arc_{};
+
+    std::vector<Index> level_index_{};
+    std::vector<Index> level_nodes_{};
+
+    std::vector<Index> input_offset_;
+    std::vector<Index> input_arc_{};
+    std::vector<bool> input_upward_{};
+};
+
+using CustomizableContractionHierarchy = CustomizableContractionHierarchyT<>;
+
+
+// Elimination tree query. All upper neighbors of a node are its ancestors in the elimination tree, so the upward search
+// from a node only visits the path to the root and can scan it in order without a priority queue. The distance is the
+// minimum over the common ancestors of start and end.
+template<class CCHClass>
+class CustomizableContractionHierarchyHelper {
+private:
+    using NodeHandle = typename CCHClass::NodeHandle;
+
+    static constexpr auto infty = std::numeric_limits<double>::infinity();
+
+    const CCHClass &cch;
+
+    std::vector<double> forward_distance;
+    std::vector<double> backward_distance;
+
+    template<bool Forward>
+    void search(std::size_t r, std::vector<double> &distance) {
+        distance[r] = 0.0;
+        for (; r != cch.numNodes(); r = cch.parent(r)) {
+            auto d_r = distance[r];
+            if (d_r == infty) continue;
+            for (auto a = cch.beginArcs(r); a < cch.endArcs(r); ++a) {
+                auto w = Forward ? cch.upWeight(a) : cch.downWeight(a);
+                auto &d_h = distance[cch.arcHead(a)];
+                d_h = std::min(d_h, d_r + w);
+            }
+        }
+    }
+
+    void reset(std::size_t r, std::vector<double> &distance) {
+        for (; r != cch.numNodes(); r = cch.parent(r)) distance[r] = infty;
+    }
+
+public:
+    explicit CustomizableContractionHierarchyHelper(const CCHClass &cch)
+            : cch(cch), forward_distance(cch.numNodes(), infty), backward_distance(cch.numNodes(), infty) {}
+
+    double dijkstra(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0.0;
+        }
+
+        auto s = cch.rank(start), t = cch.rank(end);
+        search<true>(s, forward_distance);
+        search<false>(t, backward_distance);
+
+        double shortest = infty;
+        for (auto r = t; r != cch.numNodes(); r = cch.parent(r)) {
+            shortest = std::min(shortest, forward_distance[r] + backward_distance[r]);
+        }
+
+        reset(s, forward_distance);
+        reset(t, backward_distance);
+        return shortest;
+    }
+};
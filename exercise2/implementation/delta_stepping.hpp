@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "omp.h"
+
+// Parallel single source shortest paths with delta-stepping [Meyer and Sanders 2003]. Computes the distances from one
+// node to all nodes, like DijkstraHelper::dijkstra(start):
+/*
+  auto helper    = DeltaSteppingHelper<WeightedGraphSeparated>(graph, delta);
+  auto distances = helper.sssp(handle);  // indexed by node id
+*/
+// The nodes are kept in buckets of width delta. All nodes of the current bucket are processed in parallel, relaxing
+// only their light edges (weight <= delta), which may insert nodes into the same bucket again. Once the bucket stays
+// empty, the heavy edges of all nodes removed from it are relaxed once. Every thread keeps its own buckets, the nodes of
+// the current bucket are collected from all threads in one shared frontier. Distances are updated with an atomic min.
+
+template<class WeightedGraphClass>
+class DeltaSteppingHelper {
+private:
+    using GraphType = WeightedGraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+
+    struct Arc {
+        std::size_t head;
+        double weight;
+    };
+
+    static constexpr auto no_bucket = std::numeric_limits<std::size_t>::max();
+
+    const GraphType &graph;
+    double delta_{1.0};
+
+    // light and heavy edges of every node id
+    std::vector<std::size_t> light_index{};
+    std::vector<Arc> light_arcs{};
+    std::vector<std::size_t> heavy_index{};
+    std::vector<Arc> heavy_arcs{};
+
+    std::vector<double> distance{};
+    std::vector<std::size_t> frontier{};
+    std::vector<std::vector<std::vector<std::size_t>>> local_buckets{};
+    std::vector<std::size_t> local_offsets{};
+    std::vector<std::size_t> local_next{};
+
+    [[nodiscard]] std::size_t bucket(double d) const {
+        return static_cast<std::size_t>(d / delta_);
+    }
+
+    // returns true if value was smaller than target
+    static bool atomicMin(double &target, double value) {
+        std::atomic_ref<double> ref(target);
+        auto current = ref.load(std::memory_order_relaxed);
+        while (value < current) {
+            if (ref.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void relax(const std::vector<std::size_t> &index, const std::vector<Arc> &arcs, std::size_t u_id, double d_u,
+               std::vector<std::vector<std::size_t>> &buckets) {
+        for (auto k = index[u_id]; k < index[u_id + 1]; ++k) {
+            auto [v_id, w] = arcs[k];
+            auto d_v = d_u + w;
+            if (atomicMin(distance[v_id], d_v)) {
+                auto b = bucket(d_v);
+                if (b >= buckets.size()) buckets.resize(b + 1);
+                buckets[b].push_back(v_id);
+            }
+        }
+    }
+
+    void split() {
+        const auto n = graph.numNodes();
+        light_index.assign(n + 1, 0);
+        heavy_index.assign(n + 1, 0);
+        light_arcs.clear();
+        heavy_arcs.clear();
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                Arc arc{graph.nodeId(graph.edgeHead(e)), graph.edgeWeight(e)};
+                (arc.weight <= delta_ ? light_arcs : heavy_arcs).push_back(arc);
+            }
+            light_index[u + 1] = light_arcs.size();
+            heavy_index[u + 1] = heavy_arcs.size();
+        }
+    }
+
+public:
+    /**
+     * Uses the mean edge weight as bucket width.
+     */
+    explicit DeltaSteppingHelper(const GraphType &graph) : DeltaSteppingHelper(graph, meanEdgeWeight(graph)) {}
+
+    DeltaSteppingHelper(const GraphType &graph, double delta) : graph(graph) {
+        setDelta(delta);
+    }
+
+    static double meanEdgeWeight(const GraphType &graph) {
+        double sum = 0.0;
+        std::size_t count = 0;
+        for (std::size_t u = 0; u < graph.numNodes(); ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                sum += graph.edgeWeight(e);
+                count++;
+            }
+        }
+        return count == 0 || sum == 0.0 ? 1.0 : sum / static_cast<double>(count);
+    }
+
+    [[nodiscard]] double delta() const {
+        return delta_;
+    }
+
+    /**
+     * Changes the bucket width and splits the edges into light and heavy edges again.
+     */
+    void setDelta(double delta) {
+        if (!(delta > 0.0) || !std::isfinite(delta)) {
+            throw std::runtime_error("delta must be positive and finite");
+        }
+        delta_ = delta;
+        split();
+    }
+
+    // Returns the distances from start to all nodes, indexed by node id. The reference is valid until the next query.
+    const std::vector<double> &sssp(NodeHandle start) {
+        const auto n = graph.numNodes();
+        distance.assign(n, std::numeric_limits<double>::infinity());
+
+        auto start_id = graph.nodeId(start);
+        distance[start_id] = 0.0;
+        frontier.assign(1, start_id);
+        std::size_t current = 0;
+
+        #pragma omp parallel default(none) shared(current)
+        {
+            const auto id = static_cast<std::size_t>(omp_get_thread_num());
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+
+            #pragma omp single
+            {
+                local_offsets.assign(num_threads + 1, 0);
+                local_next.assign(num_threads, no_bucket);
+                if (local_buckets.size() < num_threads) local_buckets.resize(num_threads);
+            }
+
+            auto &buckets = local_buckets[id];
+            std::vector<std::size_t> removed;
+
+            // moves the nodes of bucket b of all threads into the frontier
+            auto gather = [&](std::size_t b) {
+                local_offsets[id + 1] = b < buckets.size() ? buckets[b].size() : 0;
+
+                #pragma omp barrier
+
+                #pragma omp single
+                {
+                    std::inclusive_scan(local_offsets.begin(), local_offsets.end(), local_offsets.begin());
+                    frontier.resize(local_offsets[num_threads]);
+                }
+
+                if (b < buckets.size()) {
+                    std::copy(buckets[b].begin(), buckets[b].end(), frontier.begin() + local_offsets[id]);
+                    buckets[b].clear();
+                }
+
+                #pragma omp barrier
+            };
+
+            // current and frontier are only written in single blocks, which every thread reaches after it read them
+            while (current != no_bucket) {
+                const auto b = current;
+
+                while (!frontier.empty()) {
+                    #pragma omp for schedule(dynamic, 64)
+                    for (std::size_t i = 0; i < frontier.size(); ++i) {
+                        auto u_id = frontier[i];
+                        auto d_u = std::atomic_ref<double>(distance[u_id]).load(std::memory_order_relaxed);
+                        // skip stale entries of nodes that have been processed in an earlier bucket
+                        if (bucket(d_u) != b) continue;
+                        removed.push_back(u_id);
+                        relax(light_index, light_arcs, u_id, d_u, buckets);
+                    }
+
+                    gather(b);
+                }
+
+                // the distances of all removed nodes are final, heavy edges lead to later buckets
+                for (auto u_id: removed) {
+                    relax(heavy_index, heavy_arcs, u_id, distance[u_id], buckets);
+                }
+                removed.clear();
+
+                // starts at b in case rounding put the head of a heavy edge into the current bucket
+                local_next[id] = no_bucket;
+                for (auto next = b; next < buckets.size(); ++next) {
+                    if (!buckets[next].empty()) {
+                        local_next[id] = next;
+                        break;
+                    }
+                }
+
+                #pragma omp barrier
+
+                #pragma omp single
+                current = *std::min_element(local_next.begin(), local_next.end());
+
+                if (current != no_bucket) {
+                    gather(current);
+                }
+            }
+        }
+
+        return distance;
+    }
+};
@@ -3,7 +3,10 @@
 #include <cstddef>
 #include <cassert>
 
+#include "components.hpp"
 #include "indexed_priority_queue.hpp"
+#include "predecessors.hpp"
+#include "timestamped_vector.hpp"
 
 // Construct your Dijkstra implementation here.  It should be used by first
 // creating a DijkstraHelper with your graph, and then calling dijkstra on the helper
@@ -16,7 +19,14 @@
   auto distance   = nodeHelper.dijkstra(handle1, handle2);
 */
 
-template<class WeightedGraphClass>
+// The priority queue is a policy. Besides IndexedPriorityQueue, the monotone queues from monotone_queues.hpp can be used.
+// They do not support decrease-key and leave stale elements in the queue, which are skipped when they are popped.
+// With TrackPredecessors every search also stores the parent of each reached node, and path(end) returns the nodes of the
+// path to end found by the last search. Without it, the parents are never written.
+// After setComponents, point-to-point queries between nodes that cannot reach each other return without a search.
+
+template<class WeightedGraphClass, class Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>,
+        bool TrackPredecessors = false>
 class DijkstraHelper {
 private:
     using GraphType = WeightedGraphClass;
@@ -25,8 +35,24 @@ private:
 
     const GraphType &graph;
 
-    std::vector<double> distance{};
-    IndexedPriorityQueue<decltype(graph.nodeId(graph.node(0))), double, std::greater<>> queue;
+    TimestampedVector<double> distance{};
+    TimestampedVector<bool> is_target{};
+    std::vector<double> all_distances{};
+    Queue queue;
+    PredecessorArray predecessors{};
+    const ComponentIndex *components{nullptr};
+
+    void resetPredecessors(std::size_t start_id) {
+        if constexpr (TrackPredecessors) {
+            predecessors.reset(graph.numNodes(), start_id);
+        }
+    }
+
+    void setPredecessor(std::size_t v_id, std::size_t u_id) {
+        if constexpr (TrackPredecessors) {
+            predecessors.set(v_id, u_id);
+        }
+    }
 
     static_assert(std::is_same_v<decltype(graph.nodeId(graph.node(0))), std::size_t>);
 public:
@@ -34,23 +60,33 @@ public:
         queue.reserve(graph.numNodes());
     }
 
+    // Components of the graph to filter unreachable queries, nullptr to search always.
+    void setComponents(const ComponentIndex *index) {
+        components = index;
+    }
+
     double dijkstra(NodeHandle start, NodeHandle end) {
         constexpr auto infty = std::numeric_limits<double>::infinity();
 
+        auto start_id = graph.nodeId(start);
+        resetPredecessors(start_id);
+
         if (start == end) {
             return 0.0;
         }
-
-        auto start_id = graph.nodeId(start);
+        if (components && !components->mayReach(start_id, graph.nodeId(end))) {
+            return infty;
+        }
 
         queue.clear();
         queue.push(start_id, 0.0);
 
         distance.assign(graph.numNodes(), infty);
-        distance[start_id] = 0.0;
+        distance.set(start_id, 0.0);
 
         while (!queue.empty()) {
             auto [u_id, d_u] = queue.pop();
+            if (d_u > distance[u_id]) continue;
             auto u = graph.node(u_id);
             assert(d_u < infty);
 
@@ -68,11 +104,104 @@ public:
 
                 if (d_v_from_u < d_v) {
                     queue.pushOrChangePriority(v_id, d_v_from_u);
-                    distance[v_id] = d_v_from_u;
+                    distance.set(v_id, d_v_from_u);
+                    setPredecessor(v_id, u_id);
                 }
             }
         }
         return infty;
     }
 
+    // Returns the distances from start to all nodes, indexed by node id. The reference is valid until the next query.
+    const std::vector<double> &dijkstra(NodeHandle start) {
+        constexpr auto infty = std::numeric_limits<double>::infinity();
+
+        auto start_id = graph.nodeId(start);
+        resetPredecessors(start_id);
+
+        queue.clear();
+        queue.push(start_id, 0.0);
+
+        all_distances.assign(graph.numNodes(), infty);
+        all_distances[start_id] = 0.0;
+
+        while (!queue.empty()) {
+            auto [u_id, d_u] = queue.pop();
+            if (d_u > all_distances[u_id]) continue;
+            auto u = graph.node(u_id);
+
+            for (auto e = graph.beginEdges(u); e < graph.endEdges(u); ++e) {
+                auto v_id = graph.nodeId(graph.edgeHead(e));
+                auto d_v_from_u = d_u + graph.edgeWeight(e);
+
+                if (d_v_from_u < all_distances[v_id]) {
+                    queue.pushOrChangePriority(v_id, d_v_from_u);
+                    all_distances[v_id] = d_v_from_u;
+                    setPredecessor(v_id, u_id);
+                }
+            }
+        }
+        return all_distances;
+    }
+
+    // Returns the distances from start to every node in targets. The search stops as soon as all targets are settled.
+    std::vector<double> distances(NodeHandle start, const std::vector<NodeHandle> &targets) {
+        constexpr auto infty = std::numeric_limits<double>::infinity();
+
+        is_target.assign(graph.numNodes(), false);
+        std::size_t num_targets = 0;
+        for (auto t: targets) {
+            if (!is_target[graph.nodeId(t)]) {
+                is_target.set(graph.nodeId(t), true);
+                num_targets++;
+            }
+        }
+
+        auto start_id = graph.nodeId(start);
+        resetPredecessors(start_id);
+
+        queue.clear();
+        queue.push(start_id, 0.0);
+
+        distance.assign(graph.numNodes(), infty);
+        distance.set(start_id, 0.0);
+
+        while (!queue.empty() && num_targets != 0) {
+            auto [u_id, d_u] = queue.pop();
+            if (d_u > distance[u_id]) continue;
+            auto u = graph.node(u_id);
+
+            if (is_target[u_id]) {
+                num_targets--;
+            }
+
+            for (auto e = graph.beginEdges(u); e < graph.endEdges(u); ++e) {
+                auto v_id = graph.nodeId(graph.edgeHead(e));
+                auto d_v_from_u = d_u + graph.edgeWeight(e);
+
+                if (d_v_from_u < distance[v_id]) {
+                    queue.pushOrChangePriority(v_id, d_v_from_u);
+                    distance.set(v_id, d_v_from_u);
+                    setPredecessor(v_id, u_id);
+                }
+            }
+        }
+
+        std::vector<double> result(targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            result[i] = distance[graph.nodeId(targets[i])];
+        }
+        return result;
+    }
+
+    // Returns the nodes of the path from the start of the last search to end, empty if end was not reached. The path is a
+    // shortest path if end was settled, e.g. for the target of dijkstra(start, end).
+    std::vector<NodeHandle> path(NodeHandle end) const {
+        static_assert(TrackPredecessors, "path requires TrackPredecessors");
+        std::vector<NodeHandle> nodes;
+        for (auto id: predecessors.path(graph.nodeId(end))) {
+            nodes.push_back(graph.node(id));
+        }
+        return nodes;
+    }
 };
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "adj_array.hpp"
+#include "reverse_graph.hpp"
+
+// Direction-optimizing BFS [Beamer et al. 2012]. Used like BFSHelper:
+/*
+  auto helper   = DirectionOptimizingBFSHelper<AdjacencyArray>(graph);
+  auto distance = helper.bfs(handle1, handle2);
+*/
+// Small frontiers are expanded top-down from a queue. When the frontier has many outgoing edges compared to the
+// unvisited part of the graph, the search switches to bottom-up steps, where every unvisited node scans its
+// in-neighbors (using a reverse adjacency array) until it finds one in the frontier bitmap.
+
+template<class GraphClass>
+class DirectionOptimizingBFSHelper {
+private:
+    using GraphType = GraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using EdgeIterator = typename GraphType::EdgeIterator;
+    using Word = std::uint64_t;
+
+    static constexpr std::size_t word_bits = 64;
+
+    const GraphType &graph;
+    AdjacencyArray reverse_graph;
+
+    std::vector<std::size_t> degree{};
+    std::size_t num_edges{0};
+
+    std::vector<std::size_t> frontier{};
+    std::vector<std::size_t> next_frontier{};
+    std::vector<Word> frontier_bitmap{};
+    std::vector<Word> next_frontier_bitmap{};
+    std::vector<Word> visited{};
+
+    [[nodiscard]] static bool test(const std::vector<Word> &bitmap, std::size_t i) {
+        return (bitmap[i / word_bits] >> (i % word_bits)) & 1;
+    }
+
+    static void set(std::vector<Word> &bitmap, std::size_t i) {
+        bitmap[i / word_bits] |= Word{1} << (i % word_bits);
+    }
+
+    // expands the frontier queue into next_frontier, returns the sum of the degrees of next_frontier
+    std::size_t topDownStep() {
+        std::size_t next_edges = 0;
+        for (auto u_id: frontier) {
+            auto u = graph.node(u_id);
+            for (EdgeIterator e = graph.beginEdges(u); e != graph.endEdges(u); ++e) {
+                auto v_id = graph.nodeId(graph.edgeHead(e));
+                if (!test(visited, v_id)) {
+                    set(visited, v_id);
+                    next_frontier.push_back(v_id);
+                    next_edges += degree[v_id];
+                }
+            }
+        }
+        return next_edges;
+    }
+
+    // every unvisited node looks for a parent in frontier_bitmap, returns the number of nodes in next_frontier_bitmap
+    // and the sum of their degrees
+    std::pair<std::size_t, std::size_t> bottomUpStep() {
+        std::size_t next_size = 0;
+        std::size_t next_edges = 0;
+        std::fill(next_frontier_bitmap.begin(), next_frontier_bitmap.end(), 0);
+        for (std::size_t w = 0; w < visited.size(); ++w) {
+            Word unvisited = ~visited[w];
+            while (unvisited != 0) {
+                auto v_id = w * word_bits + static_cast<std::size_t>(__builtin_ctzll(unvisited));
+                unvisited &= unvisited - 1;
+                if (v_id >= graph.numNodes()) break;
+
+                auto v = reverse_graph.node(v_id);
+                for (auto e = reverse_graph.beginEdges(v); e != reverse_graph.endEdges(v); ++e) {
+                    if (test(frontier_bitmap, reverse_graph.edgeHead(e))) {
+                        set(next_frontier_bitmap, v_id);
+                        next_size++;
+                        next_edges += degree[v_id];
+                        break;
+                    }
+                }
+            }
+        }
+        for (std::size_t w = 0; w < visited.size(); ++w) {
+            visited[w] |= next_frontier_bitmap[w];
+        }
+        return {next_size, next_edges};
+    }
+
+    void queueToBitmap() {
+        std::fill(frontier_bitmap.begin(), frontier_bitmap.end(), 0);
+        for (auto u_id: frontier) {
+            set(frontier_bitmap, u_id);
+        }
+    }
+
+    void bitmapToQueue() {
+        frontier.clear();
+        for (std::size_t w = 0; w < frontier_bitmap.size(); ++w) {
+            Word bits = frontier_bitmap[w];
+            while (bits != 0) {
+                frontier.push_back(w * word_bits + static_cast<std::size_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+public:
+    // switch to bottom-up if frontier edges > unexplored edges / alpha
+    double alpha = 15.0;
+    // switch back to top-down if frontier nodes < nodes / beta
+    double beta = 18.0;
+
+    explicit DirectionOptimizingBFSHelper(const GraphType &graph)
+            : graph(graph), reverse_graph(graph.numNodes(), reversedEdgeList(graph)), degree(graph.numNodes()) {
+        for (std::size_t u_id = 0; u_id < graph.numNodes(); ++u_id) {
+            auto u = graph.node(u_id);
+            for (EdgeIterator e = graph.beginEdges(u); e != graph.endEdges(u); ++e) {
+                degree[u_id]++;
+            }
+            num_edges += degree[u_id];
+        }
+
+        auto num_words = (graph.numNodes() + word_bits - 1) / word_bits;
+        frontier.reserve(graph.numNodes());
+        next_frontier.reserve(graph.numNodes());
+        frontier_bitmap.resize(num_words);
+        next_frontier_bitmap.resize(num_words);
+        visited.resize(num_words);
+    }
+
+    std::size_t bfs(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0;
+        }
+
+        auto start_id = graph.nodeId(start);
+        auto end_id = graph.nodeId(end);
+
+        std::fill(visited.begin(), visited.end(), 0);
+        set(visited, start_id);
+
+        frontier.clear();
+        frontier.push_back(start_id);
+        next_frontier.clear();
+
+        bool top_down = true;
+        std::size_t frontier_size = 1;
+        std::size_t frontier_edges = degree[start_id];
+        std::size_t unexplored_edges = num_edges - frontier_edges;
+
+        for (std::size_t distance = 1; frontier_size != 0; ++distance) {
+            if (top_down && static_cast<double>(frontier_edges) > static_cast<double>(unexplored_edges) / alpha) {
+                queueToBitmap();
+                top_down = false;
+            } else if (!top_down && static_cast<double>(frontier_size) <
+                                    static_cast<double>(graph.numNodes()) / beta) {
+                bitmapToQueue();
+                top_down = true;
+            }
+
+            if (top_down) {
+                frontier_edges = topDownStep();
+                frontier_size = next_frontier.size();
+                std::swap(frontier, next_frontier);
+                next_frontier.clear();
+            } else {
+                std::tie(frontier_size, frontier_edges) = bottomUpStep();
+                std::swap(frontier_bitmap, next_frontier_bitmap);
+            }
+            unexplored_edges -= frontier_edges;
+
+            if (test(visited, end_id)) {
+                return distance;
+            }
+        }
+        return std::numeric_limits<std::size_t>::max();
+    }
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "omp.h"
+
+#include "contraction_hierarchy.hpp"
+#include "dijkstra.hpp"
+#include "parallel_csr.hpp"
+
+// Many-to-many shortest path distances. The result is a row major table, i.e. the distance from sources[i] to
+// targets[j] is stored at position i * targets.size() + j.
+/*
+  auto table = distanceTable(graph, sources, targets);
+*/
+
+/**
+ * One one-to-many Dijkstra search per source. The sources are distributed over the OpenMP threads, every thread uses its
+ * own DijkstraHelper.
+ */
+template<class WeightedGraphClass>
+std::vector<double> distanceTable(const WeightedGraphClass &graph,
+                                  const std::vector<typename WeightedGraphClass::NodeHandle> &sources,
+                                  const std::vector<typename WeightedGraphClass::NodeHandle> &targets) {
+    std::vector<double> table(sources.size() * targets.size());
+
+    #pragma omp parallel default(none) shared(graph, sources, targets, table)
+    {
+        DijkstraHelper<WeightedGraphClass> dijkstra(graph);
+
+        #pragma omp for schedule(dynamic, 1)
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            auto row = dijkstra.distances(sources[i], targets);
+            std::copy(row.begin(), row.end(), table.begin() + static_cast<std::ptrdiff_t>(i * targets.size()));
+        }
+    }
+    return table;
+}
+
+/**
+ * Entry in the bucket of node: the distance from node to the target with the given index.
+ */
+template<class Index>
+struct BucketEntry {
+    Index node;
+    std::size_t target;
+    double distance;
+};
+
+/**
+ * Bucket based many-to-many algorithm on a contraction hierarchy [Knopp et al. 2007]. The backward search space of every
+ * target is stored in buckets at the settled nodes. Afterwards, the forward search space of every source is scanned and
+ * the buckets of all settled nodes give the candidate distances to the targets. Both phases run in parallel.
+ */
+template<class Index>
+std::vector<double> distanceTable(const ContractionHierarchyT<Index> &ch,
+                                  const std::vector<typename ContractionHierarchyT<Index>::NodeHandle> &sources,
+                                  const std::vector<typename ContractionHierarchyT<Index>::NodeHandle> &targets) {
+    using CH = ContractionHierarchyT<Index>;
+    constexpr auto infty = std::numeric_limits<double>::infinity();
+
+    std::vector<std::vector<BucketEntry<Index>>> local_entries(static_cast<std::size_t>(omp_get_max_threads()));
+
+    #pragma omp parallel default(none) shared(ch, targets, local_entries)
+    {
+        ContractionHierarchyHelper<CH> helper(ch);
+        auto &entries = local_entries[static_cast<std::size_t>(omp_get_thread_num())];
+
+        #pragma omp for schedule(dynamic, 1)
+        for (std::size_t j = 0; j < targets.size(); ++j) {
+            for (auto [v, d]: helper.backwardSearchSpace(targets[j])) {
+                entries.push_back({static_cast<Index>(v), j, d});
+            }
+        }
+    }
+
+    std::vector<BucketEntry<Index>> entries;
+    for (auto &local: local_entries) {
+        entries.insert(entries.end(), local.begin(), local.end());
+        std::vector<BucketEntry<Index>>().swap(local);
+    }
+
+    std::vector<std::size_t> bucket_target(entries.size());
+    std::vector<double> bucket_distance(entries.size());
+    auto bucket_index = parallel_csr::build<std::size_t>(
+            ch.numNodes(), entries, [](const BucketEntry<Index> &e) { return e.node; },
+            [&](std::size_t position, const BucketEntry<Index> &e) {
+                bucket_target[position] = e.target;
+                bucket_distance[position] = e.distance;
+            });
+
+    std::vector<double> table(sources.size() * targets.size(), infty);
+
+    #pragma omp parallel default(none) shared(ch, sources, targets, table, bucket_index, bucket_target, bucket_distance)
+    {
+        ContractionHierarchyHelper<CH> helper(ch);
+
+        #pragma omp for schedule(dynamic, 1)
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            double *row = &table[i * targets.size()];
+            for (auto [u, d_u]: helper.forwardSearchSpace(sources[i])) {
+                for (auto k = bucket_index[u]; k < bucket_index[u + 1]; ++k) {
+                    row[bucket_target[k]] = std::min(row[bucket_target[k]], d_u + bucket_distance[k]);
+                }
+            }
+        }
+    }
+    return table;
+}
@@ -6,13 +6,32 @@
 #include <string>
 #include <vector>
 
-struct Edge {
-    std::uint64_t from;
-    std::uint64_t to;
-    double length;
+template<class Node, class Weight>
+struct EdgeT {
+    Node from;
+    Node to;
+    Weight length;
 };
 
-using EdgeList = std::vector<Edge>;
+template<class Node, class Weight>
+using EdgeListT = std::vector<EdgeT<Node, Weight>>;
+
+using Edge = EdgeT<std::uint64_t, double>;
+using EdgeList = EdgeListT<std::uint64_t, double>;
+
+/**
+ * Returns a copy of the edges with narrower node and weight types, e.g. compactEdges<uint32_t, float>(edges).
+ * The caller has to make sure that the values fit, see index_selection.hpp.
+ */
+template<class Node, class Weight>
+EdgeListT<Node, Weight> compactEdges(const EdgeList &edges) {
+    EdgeListT<Node, Weight> compact(edges.size());
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        compact[i] = {static_cast<Node>(edges[i].from), static_cast<Node>(edges[i].to),
+                      static_cast<Weight>(edges[i].length)};
+    }
+    return compact;
+}
 
 /**
  * Returns the list of edges and the number of nodes.
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "edge_list.hpp"
+
+// Selects the narrowest index and weight types for a graph at runtime. The graph type is passed to the callback as a
+// std::type_identity, so the code that builds and queries the graph is instantiated once per candidate type:
+/*
+  withNarrowestIndex<AdjacencyArrayT>(num_nodes, edges.size(), [&](auto type) {
+      using Graph = typename decltype(type)::type;  // AdjacencyArrayT<uint32_t> if n and m fit into 32 bits
+      auto graph  = Graph(num_nodes, edges);
+      ...
+  });
+*/
+// With 32 bit ids and offsets the index and edge arrays take half the memory, so more of the graph fits into the caches.
+
+
+/**
+ * Returns true if all node ids and the edge offsets of a graph with num_nodes nodes and num_edges edges fit into Index.
+ */
+template<class Index>
+[[nodiscard]] bool fitsIndex(std::size_t num_nodes, std::size_t num_edges) {
+    constexpr auto max = static_cast<std::size_t>(std::numeric_limits<Index>::max());
+    return num_nodes <= max && num_edges <= max;
+}
+
+/**
+ * Returns true if every edge weight is stored as a float with a relative error of at most max_relative_error. With the
+ * default of 0 the conversion has to be exact, e.g. for integer weights below 2^24.
+ */
+template<class E>
+[[nodiscard]] bool weightsFitFloat(const std::vector<E> &edges, double max_relative_error = 0.0) {
+    for (const auto &e: edges) {
+        auto w = static_cast<double>(e.length);
+        if (!std::isfinite(w) || std::abs(w) > static_cast<double>(std::numeric_limits<float>::max())) {
+            return false;
+        }
+        auto error = std::abs(static_cast<double>(static_cast<float>(w)) - w);
+        if (error > max_relative_error * std::abs(w)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Calls f with std::type_identity<GraphTemplate<uint32_t>> if the graph fits into 32 bit indices and with
+ * std::type_identity<GraphTemplate<uint64_t>> otherwise.
+ */
+template<template<class> class GraphTemplate, class F>
+decltype(auto) withNarrowestIndex(std::size_t num_nodes, std::size_t num_edges, F &&f) {
+    if (fitsIndex<std::uint32_t>(num_nodes, num_edges)) {
+        return std::forward<F>(f)(std::type_identity<GraphTemplate<std::uint32_t>>{});
+    }
+    return std::forward<F>(f)(std::type_identity<GraphTemplate<std::uint64_t>>{});
+}
+
+/**
+ * Same as withNarrowestIndex for weighted graphs with an additional weight type parameter. The weights are stored as
+ * floats if weightsFitFloat(edges, max_relative_error) holds.
+ */
+template<template<class, class> class GraphTemplate, class E, class F>
+decltype(auto) withNarrowestTypes(std::size_t num_nodes, const std::vector<E> &edges, F &&f,
+                                  double max_relative_error = 0.0) {
+    const bool use_float = weightsFitFloat(edges, max_relative_error);
+    if (fitsIndex<std::uint32_t>(num_nodes, edges.size())) {
+        if (use_float) {
+            return std::forward<F>(f)(std::type_identity<GraphTemplate<std::uint32_t, float>>{});
+        }
+        return std::forward<F>(f)(std::type_identity<GraphTemplate<std::uint32_t, double>>{});
+    }
+    if (use_float) {
+        return std::forward<F>(f)(std::type_identity<GraphTemplate<std::uint64_t, float>>{});
+    }
+    return std::forward<F>(f)(std::type_identity<GraphTemplate<std::uint64_t, double>>{});
+}
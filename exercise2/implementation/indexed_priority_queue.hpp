@@ -109,10 +109,13 @@ class IndexedPriorityQueue {
 
     /**
      * Clears all elements from the queue.
+     * Only the index entries of the keys in the queue are non-zero, so this takes time proportional to size().
      */
     void clear() {
+        for (std::size_t i = 1; i < heap_.size(); ++i) {
+            index_[heap_[i].first] = 0;
+        }
         heap_.resize(1);
-        std::fill(index_.begin(), index_.end(), 0);
     }
 
  private:
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/**
+ * Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string &file) {
+        int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("could not open " + file);
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) == -1) {
+            ::close(fd);
+            throw std::runtime_error("could not stat " + file);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+
+        if (size_ > 0) {
+            void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("could not map " + file);
+            }
+            data_ = static_cast<const char *>(data);
+        }
+
+        // the mapping stays valid after closing the file descriptor
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+    }
+
+    [[nodiscard]] const char *data() const { return data_; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    const char *data_{nullptr};
+    std::size_t size_{0};
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Monotone priority queues that can replace IndexedPriorityQueue in DijkstraHelper:
+/*
+  auto helper   = DijkstraHelper<WeightedGraphSeparated, RadixHeap<std::size_t>>(graph);
+  auto distance = helper.dijkstra(handle1, handle2);
+*/
+// Both queues are min-queues, the value of a pushed element must not be smaller than the value of the last popped
+// element. They do not support decrease-key, pushOrChangePriority inserts a new element and the old one stays in the
+// queue. The user has to skip such stale elements when they are popped.
+
+
+/**
+ * Radix heap [Ahuja et al. 1990] on the bit pattern of non-negative doubles, which has the same order as the values.
+ * An element is stored in the bucket of the highest bit in which it differs from the last popped value. Every element
+ * moves to a lower bucket at most 64 times.
+ */
+template<class K>
+class RadixHeap {
+public:
+    void reserve(std::size_t) {}
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    void push(K key, double value) {
+        assert(value >= 0.0);
+        auto bits = std::bit_cast<std::uint64_t>(value);
+        assert(bits >= last_);
+        buckets_[bucket(bits)].push_back({bits, key});
+        size_++;
+    }
+
+    void pushOrChangePriority(K key, double value) {
+        push(key, value);
+    }
+
+    /**
+     * Removes the smallest element from the queue.
+     * The queue must not be empty.
+     */
+    std::pair<K, double> pop() {
+        if (buckets_[0].empty()) {
+            std::size_t i = 1;
+            while (buckets_[i].empty()) ++i;
+
+            last_ = buckets_[i][0].bits;
+            for (const auto &entry: buckets_[i]) {
+                last_ = std::min(last_, entry.bits);
+            }
+            for (const auto &entry: buckets_[i]) {
+                buckets_[bucket(entry.bits)].push_back(entry);
+            }
+            buckets_[i].clear();
+        }
+
+        auto entry = buckets_[0].back();
+        buckets_[0].pop_back();
+        size_--;
+        return {entry.key, std::bit_cast<double>(entry.bits)};
+    }
+
+    void clear() {
+        for (auto &b: buckets_) b.clear();
+        size_ = 0;
+        last_ = 0;
+    }
+
+private:
+    struct Entry {
+        std::uint64_t bits;
+        K key;
+    };
+
+    // bucket 0 holds the elements equal to last_, bucket i the elements whose highest differing bit is i - 1
+    std::array<std::vector<Entry>, 65> buckets_{};
+    std::size_t size_{0};
+    std::uint64_t last_{0};
+
+    [[nodiscard]] std::size_t bucket(std::uint64_t bits) const {
+        return bits == last_ ? 0 : 64 - static_cast<std::size_t>(std::countl_zero(bits ^ last_));
+    }
+};
+
+
+/**
+ * Bucket queue [Dial 1969] for non-negative integer values, e.g. BFS distances with unit weights. The buckets form a
+ * ring that covers the values from the current minimum to the largest value in the queue. The ring grows when a value
+ * does not fit, so the maximum edge weight does not have to be known in advance.
+ */
+template<class K>
+class DialQueue {
+public:
+    void reserve(std::size_t) {}
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    void push(K key, double value) {
+        auto v = static_cast<std::size_t>(value);
+        assert(static_cast<double>(v) == value);
+        assert(v >= current_);
+        if (v - current_ >= ring_.size()) {
+            grow(v - current_ + 1);
+        }
+        ring_[v & (ring_.size() - 1)].emplace_back(key, value);
+        size_++;
+    }
+
+    void pushOrChangePriority(K key, double value) {
+        push(key, value);
+    }
+
+    /**
+     * Removes the smallest element from the queue.
+     * The queue must not be empty.
+     */
+    std::pair<K, double> pop() {
+        while (ring_[current_ & (ring_.size() - 1)].empty()) ++current_;
+        auto &bucket = ring_[current_ & (ring_.size() - 1)];
+        auto entry = bucket.back();
+        bucket.pop_back();
+        size_--;
+        return entry;
+    }
+
+    void clear() {
+        for (auto &b: ring_) b.clear();
+        size_ = 0;
+        current_ = 0;
+    }
+
+private:
+    // the size of the ring is a power of two, every slot only holds elements with the same value
+    std::vector<std::vector<std::pair<K, double>>> ring_ = std::vector<std::vector<std::pair<K, double>>>(1);
+    std::size_t size_{0};
+    std::size_t current_{0};
+
+    void grow(std::size_t min_size) {
+        std::vector<std::vector<std::pair<K, double>>> ring(std::bit_ceil(min_size));
+        for (auto &b: ring_) {
+            for (const auto &entry: b) {
+                ring[static_cast<std::size_t>(entry.second) & (ring.size() - 1)].push_back(entry);
+            }
+        }
+        ring_ = std::move(ring);
+    }
+};
@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "omp.h"
+
+#include "customizable_contraction_hierarchy.hpp"
+#include "edge_list.hpp"
+#include "indexed_priority_queue.hpp"
+#include "partition.hpp"
+#include "timestamped_vector.hpp"
+
+// Multi-level overlay graphs as in Customizable Route Planning [Delling et al. 2011]:
+/*
+  auto overlay  = MultiLevelOverlay(graph, {256, 4096, 65536});  // maximum cell size of every level
+  auto helper   = MultiLevelOverlayHelper<MultiLevelOverlay>(overlay);
+  auto distance = helper.dijkstra(overlay.node(1), overlay.node(2));
+
+  overlay.updateWeights(updates);  // customizes only the cells that contain an updated edge
+*/
+// The nodes are partitioned into nested cells (see multilevelPartition). A boundary node of a level has an edge to or
+// from another cell of that level. For every cell, the overlay stores the distances inside the cell between all of its
+// boundary nodes as a matrix. The matrices of level 0 are computed on the graph, the matrices of level l on the
+// overlay of level l - 1. Cells of one level are independent and customized in parallel. A query only enters the cells
+// of start and end and skips every other cell on the highest level that contains neither of them.
+
+template<class Index = uint64_t>
+class MultiLevelOverlayT {
+public:
+    using NodeHandle = Index;
+
+    static inline const std::vector<std::size_t> default_cell_sizes{1u << 8, 1u << 12, 1u << 16};
+
+    /**
+     * Partitions the graph by recursive bisection and customizes the overlay with the weights of the graph.
+     */
+    template<class WeightedGraphClass>
+    explicit MultiLevelOverlayT(const WeightedGraphClass &graph,
+                                const std::vector<std::size_t> &max_cell_sizes = default_cell_sizes)
+            : MultiLevelOverlayT(graph, multilevelPartition(
+            graph.numNodes(), customizable_contraction_hierarchy::edgeList(graph), max_cell_sizes)) {}
+
+    template<class WeightedGraphClass>
+    MultiLevelOverlayT(const WeightedGraphClass &graph, const MultilevelPartition &partition)
+            : num_cells_(partition.num_cells) {
+        const auto n = graph.numNodes();
+        const auto num_levels = partition.numLevels();
+        if (n >= static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+        if (num_levels > static_cast<std::size_t>(std::numeric_limits<uint8_t>::max())) {
+            throw std::runtime_error("too many levels");
+        }
+        cell_.assign(num_levels, std::vector<Index>(n));
+        for (std::size_t l = 0; l < num_levels; ++l) {
+            if (partition.cell[l].size() != n) {
+                throw std::runtime_error("partition does not match the graph");
+            }
+            for (std::size_t v = 0; v < n; ++v) {
+                cell_[l][v] = static_cast<Index>(partition.cell[l][v]);
+            }
+        }
+
+        first_arc_.assign(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e) {
+                auto v = graph.nodeId(graph.edgeHead(e));
+                arc_head_.push_back(static_cast<Index>(v));
+                arc_weight_.push_back(graph.edgeWeight(e));
+                uint8_t level = 0;
+                while (level < num_levels && cell_[level][u] != cell_[level][v]) ++level;
+                arc_level_.push_back(level);
+            }
+            first_arc_[u + 1] = static_cast<Index>(arc_head_.size());
+        }
+        if (arc_head_.size() >= static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+
+        // boundary nodes of every cell, sorted by cell and id
+        boundary_begin_.resize(num_levels);
+        boundary_nodes_.resize(num_levels);
+        boundary_index_.assign(num_levels, std::vector<Index>(n, no_index));
+        matrix_begin_.resize(num_levels);
+        matrix_.resize(num_levels);
+        for (std::size_t l = 0; l < num_levels; ++l) {
+            std::vector<bool> is_boundary(n, false);
+            for (std::size_t u = 0; u < n; ++u) {
+                for (auto a = first_arc_[u]; a < first_arc_[u + 1]; ++a) {
+                    if (arc_level_[a] > l) {
+                        is_boundary[u] = true;
+                        is_boundary[arc_head_[a]] = true;
+                    }
+                }
+            }
+
+            auto &begin = boundary_begin_[l];
+            begin.assign(num_cells_[l] + 1, 0);
+            for (std::size_t v = 0; v < n; ++v) {
+                if (is_boundary[v]) begin[cell_[l][v] + 1]++;
+            }
+            std::partial_sum(begin.begin(), begin.end(), begin.begin());
+
+            auto &nodes = boundary_nodes_[l];
+            nodes.resize(begin.back());
+            std::vector<Index> next(begin.begin(), begin.end() - 1);
+            for (std::size_t v = 0; v < n; ++v) {
+                if (!is_boundary[v]) continue;
+                auto c = cell_[l][v];
+                boundary_index_[l][v] = static_cast<Index>(next[c] - begin[c]);
+                nodes[next[c]++] = static_cast<Index>(v);
+            }
+
+            matrix_begin_[l].assign(num_cells_[l] + 1, 0);
+            for (std::size_t c = 0; c < num_cells_[l]; ++c) {
+                std::size_t k = begin[c + 1] - begin[c];
+                matrix_begin_[l][c + 1] = matrix_begin_[l][c] + k * k;
+            }
+            matrix_[l].assign(matrix_begin_[l].back(), std::numeric_limits<double>::infinity());
+        }
+
+        customizeCells(nullptr);
+    }
+
+    /**
+     * Computes all matrices again with the weights of the graph. The graph must have the same nodes and edges in the same
+     * order as the graph the overlay was built for, only the weights may differ.
+     */
+    template<class WeightedGraphClass>
+    void customize(const WeightedGraphClass &graph) {
+        const auto n = numNodes();
+        if (graph.numNodes() != n) {
+            throw std::runtime_error("graph does not match the overlay");
+        }
+        for (std::size_t u = 0; u < n; ++u) {
+            if (customizable_contraction_hierarchy::degree(graph, u) != first_arc_[u + 1] - first_arc_[u]) {
+                throw std::runtime_error("graph does not match the overlay");
+            }
+        }
+        for (std::size_t u = 0; u < n; ++u) {
+            auto handle = graph.node(u);
+            auto a = first_arc_[u];
+            for (auto e = graph.beginEdges(handle); e < graph.endEdges(handle); ++e, ++a) {
+                arc_weight_[a] = graph.edgeWeight(e);
+            }
+        }
+        customizeCells(nullptr);
+    }
+
+    /**
+     * Sets the weight of the first edge (from, to) to length for every update, like WeightedGraphSeparated::updateWeights,
+     * and customizes the cells that contain an updated edge on every level. Throws if an edge does not exist.
+     */
+    template<class E = Edge>
+    void updateWeights(const std::vector<E> &updates) {
+        std::vector<std::vector<bool>> dirty(numLevels());
+        for (std::size_t l = 0; l < numLevels(); ++l) dirty[l].assign(num_cells_[l], false);
+
+        for (const auto &update: updates) {
+            auto u = static_cast<std::size_t>(update.from);
+            auto v = static_cast<std::size_t>(update.to);
+            if (u >= numNodes()) {
+                throw std::runtime_error("edge does not exist");
+            }
+            auto a = first_arc_[u];
+            while (a < first_arc_[u + 1] && arc_head_[a] != v) ++a;
+            if (a == first_arc_[u + 1]) {
+                throw std::runtime_error("edge does not exist");
+            }
+            arc_weight_[a] = static_cast<double>(update.length);
+            // the edge is inside the cells of u from the first level on which u and v share a cell
+            for (std::size_t l = arc_level_[a]; l < numLevels(); ++l) {
+                dirty[l][cell_[l][u]] = true;
+            }
+        }
+        customizeCells(&dirty);
+    }
+
+    [[nodiscard]] std::size_t numNodes() const {
+        return first_arc_.size() - 1;
+    }
+
+    [[nodiscard]] NodeHandle node(std::size_t n) const {
+        return n;
+    }
+
+    [[nodiscard]] std::size_t nodeId(NodeHandle n) const {
+        return n;
+    }
+
+    [[nodiscard]] std::size_t numLevels() const {
+        return cell_.size();
+    }
+
+    [[nodiscard]] std::size_t numCells(std::size_t level) const {
+        return num_cells_[level];
+    }
+
+    [[nodiscard]] std::size_t cell(std::size_t level, std::size_t v) const {
+        return cell_[level][v];
+    }
+
+    // number of overlay arcs, i.e. matrix entries, of all levels
+    [[nodiscard]] std::size_t numOverlayArcs() const {
+        std::size_t sum = 0;
+        for (const auto &matrix: matrix_) sum += matrix.size();
+        return sum;
+    }
+
+    // edges of the graph
+    [[nodiscard]] std::size_t beginArcs(std::size_t u) const {
+        return first_arc_[u];
+    }
+
+    [[nodiscard]] std::size_t endArcs(std::size_t u) const {
+        return first_arc_[u + 1];
+    }
+
+    [[nodiscard]] std::size_t arcHead(std::size_t a) const {
+        return arc_head_[a];
+    }
+
+    [[nodiscard]] double arcWeight(std::size_t a) const {
+        return arc_weight_[a];
+    }
+
+    // number of levels on which the edge leads into another cell
+    [[nodiscard]] std::size_t arcLevel(std::size_t a) const {
+        return arc_level_[a];
+    }
+
+    // position of v among the boundary nodes of its cell on the level, or no_index
+    [[nodiscard]] std::size_t boundaryIndex(std::size_t level, std::size_t v) const {
+        return boundary_index_[level][v];
+    }
+
+    [[nodiscard]] std::size_t numBoundaryNodes(std::size_t level, std::size_t c) const {
+        return boundary_begin_[level][c + 1] - boundary_begin_[level][c];
+    }
+
+    // i-th boundary node of cell c on the level
+    [[nodiscard]] std::size_t boundaryNode(std::size_t level, std::size_t c, std::size_t i) const {
+        return boundary_nodes_[level][boundary_begin_[level][c] + i];
+    }
+
+    // distance inside cell c from its i-th to its j-th boundary node
+    [[nodiscard]] double overlayWeight(std::size_t level, std::size_t c, std::size_t i, std::size_t j) const {
+        return matrix_[level][matrix_begin_[level][c] + i * numBoundaryNodes(level, c) + j];
+    }
+
+    static constexpr auto no_index = std::numeric_limits<Index>::max();
+
+private:
+    using Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>;
+
+    // Dijkstra inside cell c of the level from its i-th boundary node, writes row i of the matrix of the cell
+    void searchCell(std::size_t level, std::size_t c, std::size_t i, TimestampedVector<double> &distance,
+                    Queue &queue) {
+        auto source = boundaryNode(level, c, i);
+        distance.assign(numNodes(), std::numeric_limits<double>::infinity());
+        distance.set(source, 0.0);
+        queue.clear();
+        queue.push(source, 0.0);
+
+        auto relax = [&](std::size_t v, double d_v) {
+            if (d_v < distance[v]) {
+                distance.set(v, d_v);
+                queue.pushOrChangePriority(v, d_v);
+            }
+        };
+
+        while (!queue.empty()) {
+            auto [u, d_u] = queue.pop();
+            if (level > 0) {
+                // overlay arcs of the subcell, the cell of u on the level below
+                auto sub = level - 1, sub_cell = cell(sub, u), sub_i = boundaryIndex(sub, u);
+                for (std::size_t j = 0; j < numBoundaryNodes(sub, sub_cell); ++j) {
+                    relax(boundaryNode(sub, sub_cell, j), d_u + overlayWeight(sub, sub_cell, sub_i, j));
+                }
+            }
+            // edges between the subcells of the cell
+            for (auto a = beginArcs(u); a < endArcs(u); ++a) {
+                if (arcLevel(a) == level) relax(arcHead(a), d_u + arcWeight(a));
+            }
+        }
+
+        auto k = numBoundaryNodes(level, c);
+        auto row = matrix_begin_[level][c] + i * k;
+        for (std::size_t j = 0; j < k; ++j) {
+            matrix_[level][row + j] = distance[boundaryNode(level, c, j)];
+        }
+    }
+
+    // customizes the cells marked as dirty, or all cells, one level after the other
+    void customizeCells(const std::vector<std::vector<bool>> *dirty) {
+        #pragma omp parallel default(none) shared(dirty)
+        {
+            TimestampedVector<double> distance;
+            Queue queue(numNodes());
+
+            for (std::size_t l = 0; l < numLevels(); ++l) {
+                #pragma omp for schedule(dynamic, 1)
+                for (std::size_t c = 0; c < num_cells_[l]; ++c) {
+                    if (dirty && !(*dirty)[l][c]) continue;
+                    for (std::size_t i = 0; i < numBoundaryNodes(l, c); ++i) {
+                        searchCell(l, c, i, distance, queue);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<Index>> cell_{};
+    std::vector<std::size_t> num_cells_;
+
+    std::vector<Index> first_arc_{};
+    std::vector<Index> arc_head_{};
+    std::vector<double> arc_weight_{};
+    std::vector<uint8_t> arc_level_{};
+
+    std::vector<std::vector<Index>> boundary_begin_{};
+    std::vector<std::vector<Index>> boundary_nodes_{};
+    std::vector<std::vector<Index>> boundary_index_{};
+
+    std::vector<std::vector<std::size_t>> matrix_begin_{};
+    std::vector<std::vector<double>> matrix_{};
+};
+
+using MultiLevelOverlay = MultiLevelOverlayT<>;
+
+
+// Unidirectional multi-level Dijkstra. A node u is scanned on the highest level l on which its cell contains neither
+// start nor end: on level 0 with all of its edges, otherwise with the overlay arcs of its cell on level l - 1 and the
+// edges that leave that cell. Such a node is always a boundary node of its cell, as it was reached by an edge into the
+// cell.
+template<class OverlayClass>
+class MultiLevelOverlayHelper {
+private:
+    using NodeHandle = typename OverlayClass::NodeHandle;
+
+    const OverlayClass &overlay;
+
+    TimestampedVector<double> distance{};
+    IndexedPriorityQueue<std::size_t, double, std::greater<>> queue;
+
+    [[nodiscard]] std::size_t queryLevel(std::size_t u, std::size_t s, std::size_t t) const {
+        std::size_t level = 0;
+        while (level < overlay.numLevels() && overlay.cell(level, u) != overlay.cell(level, s) &&
+               overlay.cell(level, u) != overlay.cell(level, t)) {
+            ++level;
+        }
+        return level;
+    }
+
+public:
+    explicit MultiLevelOverlayHelper(const OverlayClass &overlay) : overlay(overlay), queue(overlay.numNodes()) {}
+
+    double dijkstra(NodeHandle start, NodeHandle end) {
+        auto s = overlay.nodeId(start), t = overlay.nodeId(end);
+        if (s == t) {
+            return 0.0;
+        }
+
+        distance.assign(overlay.numNodes(), std::numeric_limits<double>::infinity());
+        distance.set(s, 0.0);
+        queue.clear();
+        queue.push(s, 0.0);
+
+        auto relax = [&](std::size_t v, double d_v) {
+            if (d_v < distance[v]) {
+                distance.set(v, d_v);
+                queue.pushOrChangePriority(v, d_v);
+            }
+        };
+
+        while (!queue.empty()) {
+            auto [u, d_u] = queue.pop();
+            if (u == t) {
+                return d_u;
+            }
+
+            auto level = queryLevel(u, s, t);
+            if (level > 0) {
+                auto sub = level - 1, c = overlay.cell(sub, u), i = overlay.boundaryIndex(sub, u);
+                assert(i != OverlayClass::no_index);
+                for (std::size_t j = 0; j < overlay.numBoundaryNodes(sub, c); ++j) {
+                    relax(overlay.boundaryNode(sub, c, j), d_u + overlay.overlayWeight(sub, c, i, j));
+                }
+            }
+            for (auto a = overlay.beginArcs(u); a < overlay.endArcs(u); ++a) {
+                if (overlay.arcLevel(a) >= level) relax(overlay.arcHead(a), d_u + overlay.arcWeight(a));
+            }
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Multi-source BFS (MS-BFS) [Then et al. 2014]. Computes the hop distances from every source to every target:
+/*
+  auto helper    = MultiSourceBFSHelper<AdjacencyArray>(graph);
+  auto distances = helper.bfs(sources, targets);  // distances[i * targets.size() + j] from sources[i] to targets[j]
+*/
+// The sources are processed in batches of 64. Every node stores one bit per source of the batch for the seen, frontier
+// and next frontier sets, so a single scan of the adjacency of a node advances all searches of the batch that currently
+// have this node in their frontier. A batch stops as soon as every target has been seen by every source.
+
+template<class GraphClass>
+class MultiSourceBFSHelper {
+private:
+    using GraphType = GraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using EdgeIterator = typename GraphType::EdgeIterator;
+    using Mask = std::uint64_t;
+
+    static constexpr std::size_t batch_size = 64;
+    static constexpr auto unreachable = std::numeric_limits<std::size_t>::max();
+
+    const GraphType &graph;
+
+    std::vector<Mask> seen{};
+    std::vector<Mask> frontier{};
+    std::vector<Mask> next{};
+    std::vector<std::size_t> frontier_nodes{};
+    std::vector<std::size_t> next_nodes{};
+
+    // targets as CSR, i.e. target_columns[target_index[v], target_index[v + 1]) are the columns of node v
+    std::vector<std::size_t> target_index{};
+    std::vector<std::size_t> target_columns{};
+
+    // writes the distance level for all sources of the batch in mask to all columns of node v
+    void record(std::size_t v_id, Mask mask, std::size_t first_source, std::size_t level, std::size_t num_targets,
+                std::vector<std::size_t> &distances) const {
+        while (mask != 0) {
+            auto i = first_source + static_cast<std::size_t>(__builtin_ctzll(mask));
+            mask &= mask - 1;
+            for (auto k = target_index[v_id]; k < target_index[v_id + 1]; ++k) {
+                distances[i * num_targets + target_columns[k]] = level;
+            }
+        }
+    }
+
+public:
+    explicit MultiSourceBFSHelper(const GraphType &graph)
+            : graph(graph), seen(graph.numNodes()), frontier(graph.numNodes()), next(graph.numNodes()) {
+        frontier_nodes.reserve(graph.numNodes());
+        next_nodes.reserve(graph.numNodes());
+    }
+
+    std::vector<std::size_t> bfs(const std::vector<NodeHandle> &sources, const std::vector<NodeHandle> &targets) {
+        const auto n = graph.numNodes();
+        std::vector<std::size_t> distances(sources.size() * targets.size(), unreachable);
+
+        target_index.assign(n + 1, 0);
+        for (auto t: targets) target_index[graph.nodeId(t) + 1]++;
+        std::size_t num_target_nodes = 0;
+        for (std::size_t v = 0; v < n; ++v) {
+            num_target_nodes += target_index[v + 1] != 0;
+            target_index[v + 1] += target_index[v];
+        }
+        target_columns.resize(targets.size());
+        {
+            auto position = target_index;
+            for (std::size_t j = 0; j < targets.size(); ++j) {
+                target_columns[position[graph.nodeId(targets[j])]++] = j;
+            }
+        }
+
+        for (std::size_t first = 0; first < sources.size(); first += batch_size) {
+            const auto last = std::min(first + batch_size, sources.size());
+
+            std::fill(seen.begin(), seen.end(), 0);
+            frontier_nodes.clear();
+            for (auto i = first; i < last; ++i) {
+                auto s_id = graph.nodeId(sources[i]);
+                if (frontier[s_id] == 0) frontier_nodes.push_back(s_id);
+                frontier[s_id] |= Mask{1} << (i - first);
+                seen[s_id] |= Mask{1} << (i - first);
+            }
+
+            // number of (source, target node) pairs that are not yet seen
+            auto remaining = (last - first) * num_target_nodes;
+            for (auto s_id: frontier_nodes) {
+                if (target_index[s_id] != target_index[s_id + 1]) {
+                    remaining -= static_cast<std::size_t>(__builtin_popcountll(frontier[s_id]));
+                    record(s_id, frontier[s_id], first, 0, targets.size(), distances);
+                }
+            }
+
+            for (std::size_t level = 1; !frontier_nodes.empty() && remaining != 0; ++level) {
+                next_nodes.clear();
+                for (auto u_id: frontier_nodes) {
+                    auto u = graph.node(u_id);
+                    auto mask = frontier[u_id];
+                    for (EdgeIterator e = graph.beginEdges(u); e != graph.endEdges(u); ++e) {
+                        auto v_id = graph.nodeId(graph.edgeHead(e));
+                        auto d = mask & ~seen[v_id];
+                        if (d != 0) {
+                            if (next[v_id] == 0) next_nodes.push_back(v_id);
+                            next[v_id] |= d;
+                        }
+                    }
+                    frontier[u_id] = 0;
+                }
+
+                for (auto v_id: next_nodes) {
+                    seen[v_id] |= next[v_id];
+                    if (target_index[v_id] != target_index[v_id + 1]) {
+                        remaining -= static_cast<std::size_t>(__builtin_popcountll(next[v_id]));
+                        record(v_id, next[v_id], first, level, targets.size(), distances);
+                    }
+                    frontier[v_id] = next[v_id];
+                    next[v_id] = 0;
+                }
+                std::swap(frontier_nodes, next_nodes);
+            }
+
+            for (auto u_id: frontier_nodes) frontier[u_id] = 0;
+        }
+        return distances;
+    }
+};
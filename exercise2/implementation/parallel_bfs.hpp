@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "omp.h"
+
+// Level-synchronous parallel BFS for a single source. Used like BFSHelper:
+/*
+  auto helper   = ParallelBFSHelper<AdjacencyArray>(graph);
+  auto distance = helper.bfs(handle1, handle2);
+*/
+// The nodes of the current frontier are distributed over the OpenMP threads. Each thread collects the newly
+// discovered nodes in a thread local next frontier, which are concatenated at the end of each level. Nodes are
+// claimed with an atomic fetch_or on a shared visited bitmap, so every node enters the frontier exactly once.
+
+template<class GraphClass>
+class ParallelBFSHelper {
+private:
+    using GraphType = GraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using EdgeIterator = typename GraphType::EdgeIterator;
+    using Word = std::uint64_t;
+
+    static constexpr std::size_t word_bits = 64;
+
+    const GraphType &graph;
+
+    std::vector<std::size_t> frontier{};
+    std::vector<std::size_t> next_frontier{};
+    std::vector<std::vector<std::size_t>> local_frontiers{};
+    std::vector<std::size_t> local_offsets{};
+    std::vector<Word> visited{};
+
+    // returns true if this call set the bit
+    bool claim(std::size_t i) {
+        auto &word = visited[i / word_bits];
+        auto mask = Word{1} << (i % word_bits);
+        std::atomic_ref<Word> ref(word);
+        if (ref.load(std::memory_order_relaxed) & mask) return false;
+        return !(ref.fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+
+public:
+    explicit ParallelBFSHelper(const GraphType &graph) : graph(graph) {
+        frontier.reserve(graph.numNodes());
+        next_frontier.reserve(graph.numNodes());
+        visited.resize((graph.numNodes() + word_bits - 1) / word_bits);
+    }
+
+    std::size_t bfs(NodeHandle start, NodeHandle end) {
+        if (start == end) {
+            return 0;
+        }
+
+        const auto start_id = graph.nodeId(start);
+        const auto end_id = graph.nodeId(end);
+
+        frontier.clear();
+        frontier.push_back(start_id);
+
+        constexpr auto unreachable = std::numeric_limits<std::size_t>::max();
+        std::size_t result = unreachable;
+        std::atomic<bool> found{false};
+
+        #pragma omp parallel default(none) shared(start_id, end_id, result, found, unreachable)
+        {
+            const auto id = static_cast<std::size_t>(omp_get_thread_num());
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+
+            #pragma omp single
+            {
+                local_frontiers.resize(num_threads);
+                local_offsets.assign(num_threads + 1, 0);
+            }
+
+            #pragma omp for schedule(static)
+            for (std::size_t w = 0; w < visited.size(); ++w) {
+                visited[w] = 0;
+            }
+
+            #pragma omp single
+            claim(start_id);
+
+            std::vector<std::size_t> local;
+            std::swap(local, local_frontiers[id]);
+
+            // frontier and result are only written in single blocks, which every thread reaches after it evaluated
+            // the loop condition. found may already be set by a faster thread in the next level.
+            for (std::size_t distance = 1; !frontier.empty() && result == unreachable; ++distance) {
+                local.clear();
+
+                #pragma omp for schedule(dynamic, 64)
+                for (std::size_t i = 0; i < frontier.size(); ++i) {
+                    auto u = graph.node(frontier[i]);
+                    for (EdgeIterator e = graph.beginEdges(u); e != graph.endEdges(u); ++e) {
+                        auto v_id = graph.nodeId(graph.edgeHead(e));
+                        if (claim(v_id)) {
+                            if (v_id == end_id) {
+                                found.store(true, std::memory_order_relaxed);
+                            }
+                            local.push_back(v_id);
+                        }
+                    }
+                }
+
+                local_offsets[id + 1] = local.size();
+
+                #pragma omp barrier
+
+                #pragma omp single
+                {
+                    std::inclusive_scan(local_offsets.begin(), local_offsets.end(), local_offsets.begin());
+                    next_frontier.resize(local_offsets[num_threads]);
+                    if (found.load(std::memory_order_relaxed)) {
+                        result = distance;
+                    }
+                }
+
+                std::copy(local.begin(), local.end(), next_frontier.begin() + local_offsets[id]);
+
+                #pragma omp barrier
+
+                #pragma omp single
+                {
+                    std::swap(frontier, next_frontier);
+                    local_offsets.assign(num_threads + 1, 0);
+                }
+            }
+
+            std::swap(local, local_frontiers[id]);
+        }
+
+        return result;
+    }
+};
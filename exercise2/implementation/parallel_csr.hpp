@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "omp.h"
+
+#include "edge_list.hpp"
+
+
+/**
+ * Tag to select the parallel constructor of the adjacency array based graphs, e.g.
+ *   AdjacencyArray graph(parallel_construction, num_nodes, edges);
+ */
+struct ParallelConstruction {
+};
+
+inline constexpr ParallelConstruction parallel_construction{};
+
+namespace parallel_csr {
+    /**
+     * Blocked two-pass parallel inclusive prefix sum. Each thread scans its block locally, the block sums are scanned
+     * sequentially and afterwards every thread adds the sum of all preceding blocks to its block.
+     */
+    template<class T>
+    void inclusiveScan(T *data, std::size_t n) {
+        std::vector<T> block_sums;
+
+        #pragma omp parallel default(none) shared(data, n, block_sums)
+        {
+            auto id = static_cast<std::size_t>(omp_get_thread_num());
+            auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+
+            #pragma omp single
+            block_sums.assign(num_threads + 1, 0);
+
+            std::size_t begin = n * id / num_threads;
+            std::size_t end = n * (id + 1) / num_threads;
+
+            T sum = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                sum += data[i];
+                data[i] = sum;
+            }
+            block_sums[id + 1] = sum;
+
+            #pragma omp barrier
+
+            #pragma omp single
+            std::inclusive_scan(block_sums.begin(), block_sums.end(), block_sums.begin());
+
+            T offset = block_sums[id];
+            if (offset != 0) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    data[i] += offset;
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the CSR index (of size num_nodes + 1) for the elements grouped by key(element) and calls
+     * scatter(position, element) for every element with its position in the CSR array.
+     * Degrees are counted with atomic increments and the positions are claimed with atomic increments per node, so the
+     * order of the elements of a node is not deterministic.
+     */
+    template<class Index, class E, class K, class F>
+    std::vector<Index> build(std::size_t num_nodes, const std::vector<E> &elements, K key, F scatter) {
+        if (num_nodes > static_cast<std::size_t>(std::numeric_limits<Index>::max()) ||
+            elements.size() > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+
+        std::vector<Index> c(num_nodes + 1);
+
+        #pragma omp parallel for default(none) shared(elements, key, c)
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            std::atomic_ref<Index>(c[key(elements[i]) + 1]).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inclusiveScan(c.data(), c.size());
+        std::vector<Index> index = c;
+
+        assert(c[0] == 0);
+        assert(c[num_nodes] == elements.size());
+
+        #pragma omp parallel for default(none) shared(elements, key, c, scatter)
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            const auto &e = elements[i];
+            auto position = std::atomic_ref<Index>(c[key(e)]).fetch_add(1, std::memory_order_relaxed);
+            scatter(position, e);
+        }
+
+        return index;
+    }
+
+    /**
+     * CSR index of the edges grouped by their tail, see above.
+     */
+    template<class Index, class E, class F>
+    std::vector<Index> build(std::size_t num_nodes, const std::vector<E> &edges, F scatter) {
+        return build<Index>(num_nodes, edges, [](const E &e) { return e.from; }, scatter);
+    }
+}
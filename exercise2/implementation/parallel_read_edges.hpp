@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "omp.h"
+
+#include "edge_list.hpp"
+#include "mapped_file.hpp"
+
+
+namespace parallel_read_edges {
+    [[nodiscard]] inline bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    [[nodiscard]] inline const char *skipSpace(const char *first, const char *last) {
+        while (first != last && isSpace(*first)) ++first;
+        return first;
+    }
+
+    // parses one number starting at the first non-whitespace character, returns nullptr on failure
+    template<class T>
+    [[nodiscard]] const char *parse(const char *first, const char *last, T &value) {
+        first = skipSpace(first, last);
+        auto[ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc()) return nullptr;
+        return ptr;
+    }
+
+    // returns the position after the next newline at or after first
+    [[nodiscard]] inline const char *nextLine(const char *first, const char *last) {
+        while (first != last && *first != '\n') ++first;
+        return first == last ? last : first + 1;
+    }
+
+    // parses all "from to length" lines in [first, last), first must be at the start of a line
+    template<class E>
+    bool parseChunk(const char *first, const char *last, std::vector<E> &edges) {
+        while ((first = skipSpace(first, last)) != last) {
+            E e{};
+            if (!(first = parse(first, last, e.from))) return false;
+            if (!(first = parse(first, last, e.to))) return false;
+            if (!(first = parse(first, last, e.length))) return false;
+            edges.push_back(e);
+        }
+        return true;
+    }
+}
+
+/**
+ * Returns the list of edges and the number of nodes.
+ *
+ * Same result as readEdges, but the file is memory mapped, split into newline aligned chunks and the chunks are
+ * parsed in parallel with std::from_chars. Throws if the file cannot be read or contains malformed lines.
+ * A narrower edge type can be requested, e.g. readEdgesParallel<EdgeT<uint32_t, float>>(file), ids that do not fit are
+ * reported as malformed.
+ */
+template<class E = Edge>
+std::pair<std::vector<E>, std::size_t> readEdgesParallel(const std::string &file) {
+    using namespace parallel_read_edges;
+
+    MappedFile mapped(file);
+    const char *begin = mapped.data();
+    const char *end = begin + mapped.size();
+
+    std::pair<std::vector<E>, std::size_t> edges;
+    begin = parse(begin, end, edges.second);
+    if (begin == nullptr) {
+        throw std::runtime_error(file + ": could not read number of nodes");
+    }
+
+    const auto num_chunks = static_cast<std::size_t>(omp_get_max_threads());
+    const auto chunk_size = static_cast<std::size_t>(end - begin) / num_chunks;
+
+    std::vector<const char *> chunk_begin(num_chunks + 1, end);
+    chunk_begin[0] = begin;
+    for (std::size_t i = 1; i < num_chunks; ++i) {
+        chunk_begin[i] = nextLine(std::max(begin + i * chunk_size, chunk_begin[i - 1]), end);
+    }
+
+    std::vector<std::vector<E>> chunk_edges(num_chunks);
+    std::vector<std::size_t> chunk_offset(num_chunks + 1, 0);
+    bool malformed = false;
+
+    #pragma omp parallel for schedule(static, 1) default(none) \
+            shared(num_chunks, chunk_begin, chunk_edges, chunk_offset) reduction(||: malformed)
+    for (std::size_t i = 0; i < num_chunks; ++i) {
+        // rough estimate of 20 characters per line
+        chunk_edges[i].reserve(static_cast<std::size_t>(chunk_begin[i + 1] - chunk_begin[i]) / 20);
+        if (!parseChunk(chunk_begin[i], chunk_begin[i + 1], chunk_edges[i])) malformed = true;
+        chunk_offset[i + 1] = chunk_edges[i].size();
+    }
+
+    if (malformed) {
+        throw std::runtime_error(file + ": malformed edge");
+    }
+
+    std::inclusive_scan(chunk_offset.begin(), chunk_offset.end(), chunk_offset.begin());
+
+    if (num_chunks == 1) {
+        edges.first = std::move(chunk_edges[0]);
+        return edges;
+    }
+
+    edges.first.resize(chunk_offset[num_chunks]);
+
+    #pragma omp parallel for schedule(static, 1) default(none) shared(num_chunks, chunk_edges, chunk_offset, edges)
+    for (std::size_t i = 0; i < num_chunks; ++i) {
+        std::copy(chunk_edges[i].begin(), chunk_edges[i].end(), edges.first.begin() + chunk_offset[i]);
+        std::vector<E>().swap(chunk_edges[i]);
+    }
+
+    return edges;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "adj_array.hpp"
+#include "edge_list.hpp"
+#include "reordering.hpp"
+
+// Graph partitioning by BFS level separators. Like the orderings in reordering.hpp, all functions work on the undirected
+// version of the graph:
+/*
+  auto ordering = nestedDissectionOrdering(num_nodes, edges);  // separators get the highest new ids
+  auto cells    = multilevelPartition(num_nodes, edges, {256, 4096});  // cells.cell[level][node]
+*/
+
+namespace partition {
+    /**
+     * Splits sets of nodes along BFS levels. A cell is a set of nodes, only edges between nodes of the same cell are
+     * considered. The searches mark nodes with a timestamp, so no array has to be cleared between two searches.
+     */
+    class LevelSeparator {
+    public:
+        LevelSeparator(std::size_t num_nodes, const EdgeList &edges)
+                : graph_(reordering::undirectedGraph(num_nodes, edges)), cell_(num_nodes, 0), level_(num_nodes),
+                  stamp_(num_nodes, 0) {}
+
+        /**
+         * Moves all nodes into a new cell with the given id. The nodes must currently belong to the same cell.
+         */
+        void assignCell(const std::vector<std::size_t> &nodes, std::size_t id) {
+            for (auto v: nodes) cell_[v] = id;
+        }
+
+        /**
+         * Returns the nodes of the cell of start that are reachable from start inside the cell, in BFS order, and
+         * stores their BFS level.
+         */
+        const std::vector<std::size_t> &bfs(std::size_t start) {
+            current_stamp_++;
+            order_.clear();
+            order_.push_back(start);
+            stamp_[start] = current_stamp_;
+            level_[start] = 0;
+            for (std::size_t i = 0; i < order_.size(); ++i) {
+                auto u = graph_.node(order_[i]);
+                for (auto e = graph_.beginEdges(u); e < graph_.endEdges(u); ++e) {
+                    auto v = graph_.nodeId(graph_.edgeHead(e));
+                    if (cell_[v] == cell_[order_[i]] && stamp_[v] != current_stamp_) {
+                        stamp_[v] = current_stamp_;
+                        level_[v] = level_[order_[i]] + 1;
+                        order_.push_back(v);
+                    }
+                }
+            }
+            return order_;
+        }
+
+        // true if v was reached by the last bfs
+        [[nodiscard]] bool reached(std::size_t v) const {
+            return stamp_[v] == current_stamp_;
+        }
+
+        [[nodiscard]] std::size_t level(std::size_t v) const {
+            return level_[v];
+        }
+
+        [[nodiscard]] std::size_t cell(std::size_t v) const {
+            return cell_[v];
+        }
+
+        /**
+         * Returns the BFS level that separates the connected nodes of a cell into the levels before and after it. The
+         * search starts at a pseudo-peripheral node. Among the levels that leave at most two thirds of the nodes on each
+         * side, the smallest one is chosen, otherwise the median level. The nodes stay marked with their levels.
+         */
+        std::size_t separatorLevel(std::size_t start) {
+            auto peripheral = bfs(start).back();
+            const auto &order = bfs(peripheral);
+            const auto n = order.size();
+
+            std::vector<std::size_t> level_size(level_[order.back()] + 1, 0);
+            for (auto v: order) level_size[level_[v]]++;
+
+            constexpr auto none = std::numeric_limits<std::size_t>::max();
+            std::size_t best = none, median = none;
+            std::size_t before = level_size[0];
+            for (std::size_t l = 1; l < level_size.size(); ++l) {
+                auto after = n - before - level_size[l];
+                if (3 * std::max(before, after) <= 2 * n &&
+                    (best == none || level_size[l] < level_size[best])) {
+                    best = l;
+                }
+                if (median == none && 2 * (before + level_size[l]) >= n) {
+                    median = l;
+                }
+                before += level_size[l];
+            }
+            return best != none ? best : median;
+        }
+
+    private:
+        AdjacencyArray graph_;
+        std::vector<std::size_t> cell_;
+        std::vector<std::size_t> level_;
+        std::vector<std::size_t> stamp_;
+        std::size_t current_stamp_{0};
+        std::vector<std::size_t> order_{};
+    };
+}
+
+/**
+ * Nested dissection ordering [George 1973] with BFS level separators. Every cell is split into the nodes before the
+ * separator level, the nodes after it and the separator itself, which gets the highest new ids of the cell. Disconnected
+ * cells are split into their components first. Cells with at most two nodes are numbered directly.
+ */
+inline NodeOrdering nestedDissectionOrdering(std::size_t num_nodes, const EdgeList &edges) {
+    partition::LevelSeparator separator(num_nodes, edges);
+
+    std::vector<std::size_t> order(num_nodes);
+    std::size_t num_cells = 1;
+
+    // cells as (nodes, first new id of the cell)
+    std::vector<std::pair<std::vector<std::size_t>, std::size_t>> cells;
+    cells.emplace_back(identityPermutation(num_nodes), 0);
+
+    while (!cells.empty()) {
+        auto [nodes, first] = std::move(cells.back());
+        cells.pop_back();
+
+        if (nodes.size() <= 2) {
+            std::copy(nodes.begin(), nodes.end(), order.begin() + static_cast<std::ptrdiff_t>(first));
+            continue;
+        }
+
+        if (const auto &reached = separator.bfs(nodes[0]); reached.size() < nodes.size()) {
+            std::vector<std::size_t> component = reached, rest;
+            for (auto v: nodes) {
+                if (!separator.reached(v)) rest.push_back(v);
+            }
+            separator.assignCell(component, num_cells++);
+            separator.assignCell(rest, num_cells++);
+            auto component_size = component.size();
+            cells.emplace_back(std::move(component), first);
+            cells.emplace_back(std::move(rest), first + component_size);
+            continue;
+        }
+
+        auto l = separator.separatorLevel(nodes[0]);
+        std::vector<std::size_t> before, after, separator_nodes;
+        for (auto v: nodes) {
+            if (separator.level(v) < l) {
+                before.push_back(v);
+            } else if (separator.level(v) > l) {
+                after.push_back(v);
+            } else {
+                separator_nodes.push_back(v);
+            }
+        }
+
+        std::copy(separator_nodes.begin(), separator_nodes.end(),
+                  order.begin() + static_cast<std::ptrdiff_t>(first + before.size() + after.size()));
+        separator.assignCell(separator_nodes, num_cells++);
+        separator.assignCell(before, num_cells++);
+        separator.assignCell(after, num_cells++);
+        auto before_size = before.size();
+        cells.emplace_back(std::move(before), first);
+        if (!after.empty()) {
+            cells.emplace_back(std::move(after), first + before_size);
+        }
+    }
+    return NodeOrdering(std::move(order));
+}
+
+
+/**
+ * Nested partition of the nodes into cells on several levels. Level 0 has the smallest cells, every cell of a level is
+ * contained in one cell of the next level.
+ */
+struct MultilevelPartition {
+    // cell[l][v] is the cell of node v on level l, the cells of a level are numbered from 0
+    std::vector<std::vector<std::size_t>> cell;
+    std::vector<std::size_t> num_cells;
+
+    [[nodiscard]] std::size_t numLevels() const {
+        return cell.size();
+    }
+};
+
+/**
+ * Partitions the nodes by recursive bisection, from the top level down. A cell is bisected until it has at most
+ * max_cell_sizes[l] nodes on level l, so the sizes must be increasing. A bisection orders the nodes by BFS from a
+ * pseudo-peripheral node, component by component, and splits the order in the middle.
+ */
+inline MultilevelPartition multilevelPartition(std::size_t num_nodes, const EdgeList &edges,
+                                               const std::vector<std::size_t> &max_cell_sizes) {
+    for (std::size_t l = 0; l < max_cell_sizes.size(); ++l) {
+        if (max_cell_sizes[l] == 0 || (l > 0 && max_cell_sizes[l] <= max_cell_sizes[l - 1])) {
+            throw std::runtime_error("cell sizes must be positive and increasing");
+        }
+    }
+
+    const auto num_levels = max_cell_sizes.size();
+    partition::LevelSeparator separator(num_nodes, edges);
+    std::size_t num_separator_cells = 1;
+
+    MultilevelPartition result;
+    result.cell.assign(num_levels, std::vector<std::size_t>(num_nodes, 0));
+    result.num_cells.assign(num_levels, 0);
+
+    std::vector<std::vector<std::size_t>> cells;
+    cells.push_back(identityPermutation(num_nodes));
+
+    for (auto l = num_levels; l-- > 0;) {
+        std::vector<std::vector<std::size_t>> next_cells;
+        for (auto &cell: cells) {
+            std::vector<std::vector<std::size_t>> stack;
+            stack.push_back(std::move(cell));
+            while (!stack.empty()) {
+                auto nodes = std::move(stack.back());
+                stack.pop_back();
+
+                if (nodes.size() <= max_cell_sizes[l]) {
+                    for (auto v: nodes) result.cell[l][v] = result.num_cells[l];
+                    result.num_cells[l]++;
+                    next_cells.push_back(std::move(nodes));
+                    continue;
+                }
+
+                // every component is moved into its own separator cell once it has been searched
+                const auto id = separator.cell(nodes[0]);
+                std::vector<std::size_t> order;
+                order.reserve(nodes.size());
+                for (auto v: nodes) {
+                    if (separator.cell(v) != id) continue;
+                    const auto &component = separator.bfs(separator.bfs(v).back());
+                    order.insert(order.end(), component.begin(), component.end());
+                    separator.assignCell(component, num_separator_cells++);
+                }
+
+                auto middle = order.begin() + static_cast<std::ptrdiff_t>(order.size() / 2);
+                std::vector<std::size_t> first(order.begin(), middle), second(middle, order.end());
+                separator.assignCell(first, num_separator_cells++);
+                separator.assignCell(second, num_separator_cells++);
+                stack.push_back(std::move(second));
+                stack.push_back(std::move(first));
+            }
+        }
+        cells = std::move(next_cells);
+    }
+    return result;
+}
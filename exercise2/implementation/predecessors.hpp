@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "timestamped_vector.hpp"
+
+/**
+ * Parent pointers of the last search as 32 bit node ids. Like the distances of the helpers, the array is reset in
+ * constant time at the start of every search.
+ */
+class PredecessorArray {
+public:
+    static constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * Starts a new search from start, all other nodes have no parent.
+     */
+    void reset(std::size_t num_nodes, std::size_t start) {
+        if (num_nodes > static_cast<std::size_t>(none)) {
+            throw std::runtime_error("too many nodes for 32 bit predecessors");
+        }
+        parent_.assign(num_nodes, none);
+        parent_.set(start, static_cast<std::uint32_t>(start));
+        start_ = start;
+    }
+
+    void set(std::size_t v, std::size_t parent) {
+        parent_.set(v, static_cast<std::uint32_t>(parent));
+    }
+
+    /**
+     * Returns the node ids on the path from the start of the last search to end, empty if end was not reached.
+     */
+    [[nodiscard]] std::vector<std::size_t> path(std::size_t end) const {
+        std::vector<std::size_t> nodes;
+        if (end >= parent_.size() || parent_[end] == none) {
+            return nodes;
+        }
+        for (auto v = end; v != start_; v = parent_[v]) {
+            nodes.push_back(v);
+        }
+        nodes.push_back(start_);
+        std::reverse(nodes.begin(), nodes.end());
+        return nodes;
+    }
+
+private:
+    TimestampedVector<std::uint32_t> parent_{};
+    std::size_t start_{0};
+};
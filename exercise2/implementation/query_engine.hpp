@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Answers batches of point-to-point queries concurrently on one shared, immutable graph:
+/*
+  auto engine = QueryEngine<WeightedGraphSeparated, DijkstraHelper<WeightedGraphSeparated>, DijkstraQuery>(graph, 8);
+  auto batch  = engine.run(queries);  // batch.results[i] is the answer to queries[i]
+*/
+// Every worker thread owns one helper for the lifetime of the engine, so the per-query state is allocated once and only
+// by the thread that uses it. With first touch page placement this puts the state on the NUMA node of the worker. The
+// graph itself is only read and therefore shared by all workers.
+
+struct BFSQuery {
+    template<class Helper, class NodeHandle>
+    auto operator()(Helper &helper, NodeHandle start, NodeHandle end) const {
+        return helper.bfs(start, end);
+    }
+};
+
+struct DijkstraQuery {
+    template<class Helper, class NodeHandle>
+    auto operator()(Helper &helper, NodeHandle start, NodeHandle end) const {
+        return helper.dijkstra(start, end);
+    }
+};
+
+
+/**
+ * Returns the q-quantile (0 <= q <= 1) of the values with the nearest rank method, 0 for an empty input.
+ */
+inline double percentile(std::vector<double> values, double q) {
+    if (values.empty()) return 0.0;
+    // the nearest rank is ceil(q * n), counted from 1
+    auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size())));
+    rank = std::clamp<std::size_t>(rank, 1, values.size()) - 1;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+    return values[rank];
+}
+
+
+template<class Result>
+struct QueryBatch {
+    std::vector<Result> results;
+    // latency of every query in microseconds, in the order of the queries
+    std::vector<double> latencies_us;
+    double p50_us{0.0};
+    double p99_us{0.0};
+    double p999_us{0.0};
+};
+
+
+template<class GraphClass, class Helper, class Query>
+class QueryEngine {
+private:
+    using GraphType = GraphClass;
+    using NodeHandle = typename GraphType::NodeHandle;
+    using Result = std::invoke_result_t<const Query &, Helper &, NodeHandle, NodeHandle>;
+
+    const GraphType &graph;
+    Query query;
+
+    std::vector<std::thread> workers{};
+
+    // batch state, guarded by mutex and published to the workers by incrementing generation
+    std::mutex mutex{};
+    std::condition_variable batch_started{};
+    std::condition_variable batch_finished{};
+    std::size_t generation{0};
+    std::size_t num_busy{0};
+    bool stopped{false};
+    std::exception_ptr error{};
+
+    const std::vector<std::pair<std::size_t, std::size_t>> *queries{nullptr};
+    QueryBatch<Result> *batch{nullptr};
+    std::atomic<std::size_t> next_query{0};
+
+    void work() {
+        std::unique_ptr<Helper> helper;
+        try {
+            helper = std::make_unique<Helper>(graph);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+        {
+            // report to the constructor that this worker is ready, a worker without a helper stops the engine
+            std::lock_guard lock(mutex);
+            if (--num_busy == 0) batch_finished.notify_one();
+            if (!helper) return;
+        }
+
+        std::size_t seen_generation = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                batch_started.wait(lock, [&] { return stopped || generation != seen_generation; });
+                if (stopped) return;
+                seen_generation = generation;
+            }
+
+            try {
+                std::size_t i;
+                while ((i = next_query.fetch_add(1, std::memory_order_relaxed)) < queries->size()) {
+                    auto [start, end] = (*queries)[i];
+                    auto t0 = std::chrono::steady_clock::now();
+                    batch->results[i] = query(*helper, graph.node(start), graph.node(end));
+                    auto t1 = std::chrono::steady_clock::now();
+                    batch->latencies_us[i] = std::chrono::duration<double, std::micro>(t1 - t0).count();
+                }
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                if (!error) error = std::current_exception();
+                // skip the remaining queries of the batch
+                next_query.store(queries->size(), std::memory_order_relaxed);
+            }
+
+            std::lock_guard lock(mutex);
+            if (--num_busy == 0) batch_finished.notify_one();
+        }
+    }
+
+public:
+    /**
+     * Starts num_threads workers. Each worker constructs its own Helper(graph) in its thread.
+     * Blocks until all helpers are constructed and rethrows the first exception of a Helper constructor.
+     */
+    explicit QueryEngine(const GraphType &graph, std::size_t num_threads = std::thread::hardware_concurrency(),
+                         Query query = {})
+            : graph(graph), query(std::move(query)) {
+        num_threads = std::max<std::size_t>(num_threads, 1);
+        num_busy = num_threads;
+        workers.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+
+        std::unique_lock lock(mutex);
+        batch_finished.wait(lock, [&] { return num_busy == 0; });
+        if (error) {
+            stopped = true;
+            lock.unlock();
+            batch_started.notify_all();
+            for (auto &worker: workers) worker.join();
+            std::rethrow_exception(error);
+        }
+    }
+
+    QueryEngine(const QueryEngine &) = delete;
+
+    QueryEngine &operator=(const QueryEngine &) = delete;
+
+    ~QueryEngine() {
+        {
+            std::lock_guard lock(mutex);
+            stopped = true;
+        }
+        batch_started.notify_all();
+        for (auto &worker: workers) worker.join();
+    }
+
+    [[nodiscard]] std::size_t numThreads() const {
+        return workers.size();
+    }
+
+    /**
+     * Answers all (start id, end id) queries and blocks until they are done. The queries are handed out to the workers
+     * one by one, so long queries do not delay the others. Rethrows the first exception of a worker.
+     * Must not be called concurrently.
+     */
+    QueryBatch<Result> run(const std::vector<std::pair<std::size_t, std::size_t>> &batch_queries) {
+        QueryBatch<Result> result;
+        result.results.resize(batch_queries.size());
+        result.latencies_us.resize(batch_queries.size());
+
+        {
+            std::unique_lock lock(mutex);
+            queries = &batch_queries;
+            batch = &result;
+            next_query.store(0, std::memory_order_relaxed);
+            num_busy = workers.size();
+            generation++;
+            batch_started.notify_all();
+            batch_finished.wait(lock, [&] { return num_busy == 0; });
+            queries = nullptr;
+            batch = nullptr;
+            if (error) {
+                std::rethrow_exception(std::exchange(error, nullptr));
+            }
+        }
+
+        result.p50_us = percentile(result.latencies_us, 0.5);
+        result.p99_us = percentile(result.latencies_us, 0.99);
+        result.p999_us = percentile(result.latencies_us, 0.999);
+        return result;
+    }
+};
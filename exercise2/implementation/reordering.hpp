@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "adj_array.hpp"
+#include "edge_list.hpp"
+
+// Locality improving node orderings. The edge list is relabelled before the graph is built, queries have to be
+// translated with the same ordering:
+/*
+  auto ordering = reverseCuthillMcKeeOrdering(num_nodes, edges);
+  auto graph    = AdjacencyArray(num_nodes, ordering.relabel(edges));
+  auto distance = helper.bfs(graph.node(ordering.toNew(s)), graph.node(ordering.toNew(t)));
+*/
+// Both orderings work on the undirected version of the graph and handle every connected component separately.
+
+/**
+ * A permutation of the node ids together with its inverse.
+ */
+class NodeOrdering {
+public:
+    NodeOrdering() = default;
+
+    /**
+     * Creates the ordering in which old_ids[i] gets the new id i.
+     */
+    explicit NodeOrdering(std::vector<std::size_t> old_ids) : old_id_(std::move(old_ids)), new_id_(old_id_.size()) {
+        constexpr auto unset = std::numeric_limits<std::size_t>::max();
+        std::fill(new_id_.begin(), new_id_.end(), unset);
+        for (std::size_t i = 0; i < old_id_.size(); ++i) {
+            if (old_id_[i] >= old_id_.size() || new_id_[old_id_[i]] != unset) {
+                throw std::runtime_error("not a permutation");
+            }
+            new_id_[old_id_[i]] = i;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return old_id_.size(); }
+
+    [[nodiscard]] std::size_t toNew(std::size_t old_id) const { return new_id_[old_id]; }
+
+    [[nodiscard]] std::size_t toOld(std::size_t new_id) const { return old_id_[new_id]; }
+
+    /**
+     * Returns the edge list with both endpoints translated to the new ids, in the original order.
+     */
+    [[nodiscard]] EdgeList relabel(const EdgeList &edges) const {
+        EdgeList relabelled(edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            relabelled[i] = {new_id_[edges[i].from], new_id_[edges[i].to], edges[i].length};
+        }
+        return relabelled;
+    }
+
+private:
+    std::vector<std::size_t> old_id_{};
+    std::vector<std::size_t> new_id_{};
+};
+
+
+inline std::vector<std::size_t> identityPermutation(std::size_t num_nodes) {
+    std::vector<std::size_t> ids(num_nodes);
+    std::iota(ids.begin(), ids.end(), 0);
+    return ids;
+}
+
+
+namespace reordering {
+    inline AdjacencyArray undirectedGraph(std::size_t num_nodes, const EdgeList &edges) {
+        EdgeList undirected;
+        undirected.reserve(2 * edges.size());
+        for (const auto &e: edges) {
+            undirected.push_back(e);
+            undirected.push_back({e.to, e.from, e.length});
+        }
+        return AdjacencyArray(num_nodes, undirected);
+    }
+
+    // appends the nodes of the component of start in BFS order, returns the index of the first appended node
+    template<class F>
+    std::size_t bfs(const AdjacencyArray &graph, std::size_t start, std::vector<bool> &visited,
+                    std::vector<std::size_t> &order, F &&sort_neighbors) {
+        auto first = order.size();
+        visited[start] = true;
+        order.push_back(start);
+        for (auto i = first; i < order.size(); ++i) {
+            auto u = graph.node(order[i]);
+            auto begin = order.size();
+            for (auto e = graph.beginEdges(u); e < graph.endEdges(u); ++e) {
+                auto v_id = graph.nodeId(graph.edgeHead(e));
+                if (!visited[v_id]) {
+                    visited[v_id] = true;
+                    order.push_back(v_id);
+                }
+            }
+            sort_neighbors(order.begin() + static_cast<std::ptrdiff_t>(begin), order.end());
+        }
+        return first;
+    }
+}
+
+/**
+ * Nodes are numbered in BFS order, starting each component at its smallest old id.
+ */
+inline NodeOrdering bfsOrdering(std::size_t num_nodes, const EdgeList &edges) {
+    auto graph = reordering::undirectedGraph(num_nodes, edges);
+
+    std::vector<bool> visited(num_nodes);
+    std::vector<std::size_t> order;
+    order.reserve(num_nodes);
+    for (std::size_t s = 0; s < num_nodes; ++s) {
+        if (!visited[s]) {
+            reordering::bfs(graph, s, visited, order, [](auto, auto) {});
+        }
+    }
+    return NodeOrdering(std::move(order));
+}
+
+/**
+ * Reverse Cuthill-McKee ordering. Every component starts at a pseudo-peripheral node, i.e. the last node of a BFS from
+ * the smallest old id in the component. The neighbors of a node are appended in order of increasing degree and the
+ * complete order is reversed at the end.
+ */
+inline NodeOrdering reverseCuthillMcKeeOrdering(std::size_t num_nodes, const EdgeList &edges) {
+    auto graph = reordering::undirectedGraph(num_nodes, edges);
+
+    std::vector<std::size_t> degree(num_nodes);
+    for (std::size_t u = 0; u < num_nodes; ++u) {
+        degree[u] = static_cast<std::size_t>(graph.endEdges(graph.node(u)) - graph.beginEdges(graph.node(u)));
+    }
+    auto by_degree = [&](auto begin, auto end) {
+        std::stable_sort(begin, end, [&](std::size_t a, std::size_t b) { return degree[a] < degree[b]; });
+    };
+
+    std::vector<bool> visited(num_nodes);
+    std::vector<std::size_t> order;
+    order.reserve(num_nodes);
+    for (std::size_t s = 0; s < num_nodes; ++s) {
+        if (visited[s]) continue;
+
+        // find a pseudo-peripheral node and undo the search
+        auto first = reordering::bfs(graph, s, visited, order, [](auto, auto) {});
+        auto peripheral = order.back();
+        for (auto i = first; i < order.size(); ++i) visited[order[i]] = false;
+        order.resize(first);
+
+        reordering::bfs(graph, peripheral, visited, order, by_degree);
+    }
+    std::reverse(order.begin(), order.end());
+    return NodeOrdering(std::move(order));
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+#include "edge_list.hpp"
+
+
+/**
+ * Returns the edges of the graph with head and tail swapped, i.e. the edge list of the reverse graph.
+ * Works for every graph implementation with the common beginEdges/endEdges interface.
+ */
+template<class GraphClass>
+EdgeList reversedEdgeList(const GraphClass &graph) {
+    EdgeList edges;
+    for (std::size_t u_id = 0; u_id < graph.numNodes(); ++u_id) {
+        auto u = graph.node(u_id);
+        for (auto e = graph.beginEdges(u); e != graph.endEdges(u); ++e) {
+            edges.push_back({graph.nodeId(graph.edgeHead(e)), u_id, graph.edgeWeight(e)});
+        }
+    }
+    return edges;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * A vector that can be reset to a single value in constant time.
+ * Every entry stores the epoch of its last write. assign starts a new epoch, so all entries written in earlier epochs
+ * read as the default value. The stamps are only cleared when the epoch counter wraps around.
+ */
+template<class T>
+class TimestampedVector {
+public:
+    explicit TimestampedVector(std::size_t size = 0, T value = T{}) : entries_(size), default_(value) {}
+
+    /**
+     * Resizes the vector to size and resets all entries to value.
+     */
+    void assign(std::size_t size, T value) {
+        entries_.resize(size);
+        default_ = value;
+        if (++epoch_ == 0) {
+            for (auto &entry: entries_) entry.stamp = 0;
+            epoch_ = 1;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+    [[nodiscard]] const T &operator[](std::size_t i) const {
+        return entries_[i].stamp == epoch_ ? entries_[i].value : default_;
+    }
+
+    void set(std::size_t i, T value) {
+        entries_[i] = {epoch_, value};
+    }
+
+private:
+    // stamp and value are stored together, so a read touches a single cache line
+    struct Entry {
+        std::uint32_t stamp = 0;
+        T value{};
+    };
+
+    std::vector<Entry> entries_;
+    T default_;
+    std::uint32_t epoch_{1};
+};
+
+
+/**
+ * Specialization for flags such as visited arrays. Only a 16 bit stamp is stored per entry: an entry stamped with the
+ * current epoch holds the opposite of the default value. This takes 2 bytes per entry instead of 8 for a stamp next to a
+ * padded bool. The stamps are cleared every 65535 assigns, which is amortized over as many queries.
+ */
+template<>
+class TimestampedVector<bool> {
+public:
+    explicit TimestampedVector(std::size_t size = 0, bool value = false) : stamps_(size), default_(value) {}
+
+    /**
+     * Resizes the vector to size and resets all entries to value.
+     */
+    void assign(std::size_t size, bool value) {
+        stamps_.resize(size);
+        default_ = value;
+        if (++epoch_ == 0) {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return stamps_.size(); }
+
+    [[nodiscard]] bool operator[](std::size_t i) const {
+        return (stamps_[i] == epoch_) != default_;
+    }
+
+    void set(std::size_t i, bool value) {
+        stamps_[i] = value != default_ ? epoch_ : 0;
+    }
+
+private:
+    std::vector<std::uint16_t> stamps_;
+    bool default_;
+    std::uint16_t epoch_{1};
+};
@@ -3,18 +3,27 @@
 #include <cstddef>
 #include <numeric>
 #include <cstdint>
+#include <limits>
+#include <stdexcept>
 
 #include "edge_list.hpp"
+#include "parallel_csr.hpp"
 
 
-template<class Index = uint64_t>
+template<class Index = uint64_t, class Weight = double>
 class WeightedGraphPairedT {
 public:
     using NodeHandle = Index;
-    using EdgeIterator = typename std::vector<std::pair<NodeHandle, double>>::const_iterator;
+    using EdgeIterator = typename std::vector<std::pair<NodeHandle, Weight>>::const_iterator;
 
-    explicit WeightedGraphPairedT(std::size_t num_nodes = 0, const EdgeList &edges = {})
+    template<class E = Edge>
+    explicit WeightedGraphPairedT(std::size_t num_nodes = 0, const std::vector<E> &edges = {})
             : index_(num_nodes + 1), edges_(edges.size()) {
+        if (num_nodes > static_cast<std::size_t>(std::numeric_limits<Index>::max()) ||
+            edges.size() > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+
         std::vector<Index> c(num_nodes + 1);
         for (const auto &e: edges) {
             c[e.from + 1]++;
@@ -27,10 +36,18 @@ public:
         assert(c[num_nodes] == edges.size());
 
         for (const auto &e: edges) {
-            edges_[c[e.from]++] = {e.to, e.length};
+            edges_[c[e.from]++] = {static_cast<NodeHandle>(e.to), static_cast<Weight>(e.length)};
         }
     }
 
+    template<class E>
+    WeightedGraphPairedT(ParallelConstruction, std::size_t num_nodes, const std::vector<E> &edges)
+            : edges_(edges.size()) {
+        index_ = parallel_csr::build<Index>(num_nodes, edges, [&](Index position, const E &e) {
+            edges_[position] = {static_cast<NodeHandle>(e.to), static_cast<Weight>(e.length)};
+        });
+    }
+
     [[nodiscard]] std::size_t numNodes() const {
         return index_.size() - 1;
     };
@@ -56,12 +73,12 @@ public:
     }
 
     [[nodiscard]] double edgeWeight(EdgeIterator e) const {
-        return e->second;
+        return static_cast<double>(e->second);
     }
 
 private:
     std::vector<Index> index_;
-    std::vector<std::pair<NodeHandle, double>> edges_;
+    std::vector<std::pair<NodeHandle, Weight>> edges_;
 };
 
 using WeightedGraphPaired = WeightedGraphPairedT<>;
@@ -3,17 +3,26 @@
 #include <cstddef>
 #include <numeric>
 #include <cstdint>
+#include <limits>
+#include <stdexcept>
 
 #include "edge_list.hpp"
+#include "parallel_csr.hpp"
 
-template<class Index = uint64_t>
+template<class Index = uint64_t, class Weight = double>
 class WeightedGraphSeparatedT {
 public:
     using NodeHandle = Index;
     using EdgeIterator = Index;
 
-    explicit WeightedGraphSeparatedT(std::size_t num_nodes = 0, const EdgeList &edges = {})
+    template<class E = Edge>
+    explicit WeightedGraphSeparatedT(std::size_t num_nodes = 0, const std::vector<E> &edges = {})
             : index_(num_nodes + 1), edges_(edges.size()), weights_(edges.size()) {
+        if (num_nodes > static_cast<std::size_t>(std::numeric_limits<Index>::max()) ||
+            edges.size() > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw std::runtime_error("NodeIdType too small");
+        }
+
         std::vector<Index> c(num_nodes + 1);
         for (const auto &e: edges) {
             c[e.from + 1]++;
@@ -27,12 +36,21 @@ public:
 
         for (const auto &e: edges) {
             auto &e_count = c[e.from];
-            edges_[e_count] = e.to;
-            weights_[e_count] = e.length;
+            edges_[e_count] = static_cast<NodeHandle>(e.to);
+            weights_[e_count] = static_cast<Weight>(e.length);
             e_count++;
         }
     }
 
+    template<class E>
+    WeightedGraphSeparatedT(ParallelConstruction, std::size_t num_nodes, const std::vector<E> &edges)
+            : edges_(edges.size()), weights_(edges.size()) {
+        index_ = parallel_csr::build<Index>(num_nodes, edges, [&](Index position, const E &e) {
+            edges_[position] = static_cast<NodeHandle>(e.to);
+            weights_[position] = static_cast<Weight>(e.length);
+        });
+    }
+
     [[nodiscard]] std::size_t numNodes() const {
         return index_.size() - 1;
     };
@@ -58,13 +76,45 @@ public:
     }
 
     [[nodiscard]] double edgeWeight(EdgeIterator e) const {
-        return weights_[e];
+        return static_cast<double>(weights_[e]);
+    }
+
+    // Returns the first edge from u to v or endEdges(u) if there is none.
+    [[nodiscard]] EdgeIterator findEdge(NodeHandle u, NodeHandle v) const {
+        auto e = beginEdges(u);
+        while (e < endEdges(u) && edgeHead(e) != v) ++e;
+        return e;
+    }
+
+    // Changes the weight of an edge in place. Only the weights array is written, so node handles and edge iterators stay
+    // valid. Must not be called while queries are running on the graph.
+    void setEdgeWeight(EdgeIterator e, double weight) {
+        weights_[e] = static_cast<Weight>(weight);
+    }
+
+    /**
+     * Sets the weight of the first edge (from, to) to length for every update, later updates win. Throws if an edge does
+     * not exist.
+     */
+    template<class E = Edge>
+    void updateWeights(const std::vector<E> &updates) {
+        for (const auto &update: updates) {
+            if (static_cast<std::size_t>(update.from) >= numNodes()) {
+                throw std::runtime_error("edge does not exist");
+            }
+            auto u = node(static_cast<std::size_t>(update.from));
+            auto e = findEdge(u, node(static_cast<std::size_t>(update.to)));
+            if (e == endEdges(u)) {
+                throw std::runtime_error("edge does not exist");
+            }
+            setEdgeWeight(e, static_cast<double>(update.length));
+        }
     }
 
 private:
     std::vector<Index> index_;
     std::vector<NodeHandle> edges_;
-    std::vector<double> weights_;
+    std::vector<Weight> weights_;
 };
 
 using WeightedGraphSeparated = WeightedGraphSeparatedT<>;
@@ -1,5 +1,7 @@
 #include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <map>
 #include <random>
 #include <sstream>
 
@@ -8,8 +10,28 @@
 #include "../implementation/adj_list.hpp"
 #include "../implementation/weighted_graph_paired.hpp"
 #include "../implementation/weighted_graph_separated.hpp"
+#include "../implementation/compressed_graph.hpp"
 #include "../implementation/bfs.hpp"
+#include "../implementation/direction_optimizing_bfs.hpp"
+#include "../implementation/parallel_bfs.hpp"
+#include "../implementation/multi_source_bfs.hpp"
+#include "../implementation/bidirectional.hpp"
 #include "../implementation/dijkstra.hpp"
+#include "../implementation/delta_stepping.hpp"
+#include "../implementation/components.hpp"
+#include "../implementation/monotone_queues.hpp"
+#include "../implementation/alt.hpp"
+#include "../implementation/distance_table.hpp"
+#include "../implementation/contraction_hierarchy.hpp"
+#include "../implementation/customizable_contraction_hierarchy.hpp"
+#include "../implementation/multi_level_overlay.hpp"
+#include "../implementation/parallel_read_edges.hpp"
+#include "../implementation/reordering.hpp"
+#include "../implementation/index_selection.hpp"
+#include "../implementation/query_engine.hpp"
+#include "../utils/commandline.hpp"
+#include "../utils/perf_counters.hpp"
+#include "../utils/query_counters.hpp"
 
 
 template<class GraphClass>
@@ -32,20 +54,191 @@ public:
 
 
 template<class GraphClass>
+class DirectionOptimizingBFS {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    DirectionOptimizingBFSHelper<GraphClass> bfs;
+public:
+    explicit DirectionOptimizingBFS(const GraphClass &graph) : bfs(graph) {}
+
+    std::size_t run(NodeHandle start, NodeHandle end) {
+        return bfs.bfs(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "do-bfs";
+    }
+};
+
+
+template<class GraphClass>
+class ParallelBFS {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    ParallelBFSHelper<GraphClass> bfs;
+public:
+    explicit ParallelBFS(const GraphClass &graph) : bfs(graph) {}
+
+    std::size_t run(NodeHandle start, NodeHandle end) {
+        return bfs.bfs(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "par-bfs";
+    }
+};
+
+
+template<class GraphClass>
+class BidirectionalBFS {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    BidirectionalBFSHelper<GraphClass> bfs;
+public:
+    explicit BidirectionalBFS(const GraphClass &graph) : bfs(graph) {}
+
+    std::size_t run(NodeHandle start, NodeHandle end) {
+        return bfs.bfs(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "bi-bfs";
+    }
+};
+
+
+template<class GraphClass, class Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>, bool Path = false>
 class Dijkstra {
 private:
     using NodeHandle = typename GraphClass::NodeHandle;
 
-    DijkstraHelper<GraphClass> djikstra;
+    DijkstraHelper<GraphClass, Queue, Path> djikstra;
 public:
     explicit Dijkstra(const GraphClass &graph) : djikstra(graph) {}
 
+    double run(NodeHandle start, NodeHandle end) {
+        auto distance = djikstra.dijkstra(start, end);
+        if constexpr (Path) {
+            [[maybe_unused]] auto path = djikstra.path(end);
+        }
+        return distance;
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        if constexpr (Path) {
+            return "dijkstra-path";
+        } else if constexpr (std::is_same_v<Queue, RadixHeap<std::size_t>>) {
+            return "dijkstra-radix";
+        } else if constexpr (std::is_same_v<Queue, DialQueue<std::size_t>>) {
+            return "dijkstra-dial";
+        } else {
+            return "dijkstra";
+        }
+    }
+};
+
+
+// BFS and Dijkstra that answer queries between nodes that cannot reach each other without a search. The components are
+// computed by the constructor.
+template<class GraphClass>
+class FilteredBFS {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    ComponentIndex components;
+    BFSHelper<GraphClass> bfs;
+public:
+    explicit FilteredBFS(const GraphClass &graph) : components(graph), bfs(graph) {
+        bfs.setComponents(&components);
+    }
+
+    std::size_t run(NodeHandle start, NodeHandle end) {
+        return bfs.bfs(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "bfs-scc";
+    }
+};
+
+
+template<class GraphClass>
+class FilteredDijkstra {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    ComponentIndex components;
+    DijkstraHelper<GraphClass> djikstra;
+public:
+    explicit FilteredDijkstra(const GraphClass &graph) : components(graph), djikstra(graph) {
+        djikstra.setComponents(&components);
+    }
+
+    double run(NodeHandle start, NodeHandle end) {
+        return djikstra.dijkstra(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "dijkstra-scc";
+    }
+};
+
+
+template<class GraphClass>
+class BidirectionalDijkstra {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    BidirectionalDijkstraHelper<GraphClass> djikstra;
+public:
+    explicit BidirectionalDijkstra(const GraphClass &graph) : djikstra(graph) {}
+
     double run(NodeHandle start, NodeHandle end) {
         return djikstra.dijkstra(start, end);
     }
 
     [[nodiscard]] std::string_view name() const {
-        return "dijkstra";
+        return "bi-dijkstra";
+    }
+};
+
+template<class GraphClass>
+class ALT {
+private:
+    using NodeHandle = typename GraphClass::NodeHandle;
+
+    ALTHelper<GraphClass> alt;
+public:
+    explicit ALT(const GraphClass &graph) : alt(graph) {}
+
+    double run(NodeHandle start, NodeHandle end) {
+        return alt.dijkstra(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "alt";
+    }
+};
+
+
+template<class CHClass>
+class ContractionHierarchyQuery {
+private:
+    using NodeHandle = typename CHClass::NodeHandle;
+
+    ContractionHierarchyHelper<CHClass> query;
+public:
+    explicit ContractionHierarchyQuery(const CHClass &ch) : query(ch) {}
+
+    double run(NodeHandle start, NodeHandle end) {
+        return query.dijkstra(start, end);
+    }
+
+    [[nodiscard]] std::string_view name() const {
+        return "ch";
     }
 };
 
@@ -89,19 +282,28 @@ void print_header_construction(std::ostream &out) {
     print(out, "\"algorithm total (ms)\"", 8);
     print(out, "\"algorithm mean (ms)\"", 8);
     print(out, "\"algorithm std (ms)\"", 8);
+    print(out, "\"algorithm p50 (ms)\"", 8);
+    print(out, "\"algorithm p99 (ms)\"", 8);
+    print(out, "\"algorithm p999 (ms)\"", 8);
     print(out, "\"total (ms)\"", 8);
     out << "\n";
     std::cout << "\n";
 }
 
-template<class GraphClass, class Algorithm = BFS<GraphClass>>
+template<class GraphClass, class Algorithm = BFS<GraphClass>, bool Parallel = false>
 void
 run_benchmark_construction(std::ostream &out, std::string_view graph_class_name, std::string_view graph_instance_name,
                            std::size_t num_nodes, const EdgeList &edges,
                            const std::vector<std::pair<std::size_t, std::size_t>> &queries) {
     auto t0 = std::chrono::high_resolution_clock::now();
 
-    GraphClass graph(num_nodes, edges);
+    auto graph = [&] {
+        if constexpr (Parallel) {
+            return GraphClass(parallel_construction, num_nodes, edges);
+        } else {
+            return GraphClass(num_nodes, edges);
+        }
+    }();
 
     auto t1 = std::chrono::high_resolution_clock::now();
 
@@ -137,6 +339,9 @@ run_benchmark_construction(std::ostream &out, std::string_view graph_class_name,
     print(out, run_bfs_total, 8);
     print(out, mean(bfs_times), 8);
     print(out, standard_deviation(bfs_times), 8);
+    print(out, percentile(bfs_times, 0.5), 8);
+    print(out, percentile(bfs_times, 0.99), 8);
+    print(out, percentile(bfs_times, 0.999), 8);
     print(out, total, 8);
     out << "\n";
     std::cout << "\n";
@@ -182,6 +387,327 @@ void run_benchmark_runs(std::ostream &out, std::string_view graph_class_name, st
     }
 }
 
+void print_header_table(std::ostream &out) {
+    print(out, "\"graph class name\"", 28);
+    print(out, "\"graph instance name\"", 20);
+    print(out, "\"n\"", 8);
+    print(out, "\"m\"", 8);
+    print(out, "\"algorithm\"", 12);
+    print(out, "\"graph constructor (ms)\"", 8);
+    print(out, "\"number of sources\"", 8);
+    print(out, "\"number of targets\"", 8);
+    print(out, "\"table (ms)\"", 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+template<class GraphClass, class F>
+void run_benchmark_table(std::ostream &out, std::string_view graph_class_name, std::string_view graph_instance_name,
+                         std::string_view algorithm_name, std::size_t num_nodes, const EdgeList &edges,
+                         const std::vector<std::size_t> &source_ids, const std::vector<std::size_t> &target_ids,
+                         F compute_table) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    GraphClass graph(num_nodes, edges);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<typename GraphClass::NodeHandle> sources, targets;
+    for (auto s: source_ids) sources.push_back(graph.node(s));
+    for (auto t: target_ids) targets.push_back(graph.node(t));
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    [[maybe_unused]] auto table = compute_table(graph, sources, targets);
+
+    auto t3 = std::chrono::high_resolution_clock::now();
+
+    print(out, graph_class_name, 28);
+    print(out, graph_instance_name, 20);
+    print(out, num_nodes, 8);
+    print(out, edges.size(), 8);
+    print(out, algorithm_name, 12);
+    print(out, duration_ms(t0, t1), 8);
+    print(out, sources.size(), 8);
+    print(out, targets.size(), 8);
+    print(out, duration_ms(t2, t3), 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+void print_header_profile(std::ostream &out) {
+    print(out, "\"graph class name\"", 28);
+    print(out, "\"graph instance name\"", 20);
+    print(out, "\"n\"", 8);
+    print(out, "\"m\"", 8);
+    print(out, "\"algorithm\"", 12);
+    print(out, "\"query\"", 8);
+    print(out, "\"distance\"", 8);
+    print(out, "\"algorithm (us)\"", 8);
+    print(out, "\"settled nodes\"", 8);
+    print(out, "\"relaxed edges\"", 8);
+    print(out, "\"queue operations\"", 8);
+    print(out, "\"instructions\"", 8);
+    print(out, "\"llc misses\"", 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+// Runs every query twice: once with CountingAlgorithm on a CountingGraph for the operation counts and once with
+// Algorithm on the graph itself, which is timed and measured with the hardware counters. Prints one line per query and
+// the percentiles of the query times.
+template<class GraphClass, class Algorithm, class CountingAlgorithm>
+void run_benchmark_profile(std::ostream &out, std::string_view graph_class_name, std::string_view graph_instance_name,
+                           std::size_t num_nodes, const EdgeList &edges,
+                           const std::vector<std::pair<std::size_t, std::size_t>> &queries) {
+    GraphClass graph(num_nodes, edges);
+    CountingGraph<GraphClass> counting_graph(graph);
+    Algorithm algorithm(graph);
+    CountingAlgorithm counting_algorithm(counting_graph);
+    PerfCounters perf_counters;
+
+    std::vector<double> times;
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        auto [start, end] = queries[i];
+
+        query_counters = {};
+        [[maybe_unused]] auto counted_dist = counting_algorithm.run(counting_graph.node(start), counting_graph.node(end));
+        auto counters = query_counters;
+
+        perf_counters.start();
+        auto t0 = std::chrono::high_resolution_clock::now();
+
+        auto dist = algorithm.run(graph.node(start), graph.node(end));
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        auto sample = perf_counters.stop();
+        auto t = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        times.push_back(t);
+
+        print(out, graph_class_name, 28);
+        print(out, graph_instance_name, 20);
+        print(out, num_nodes, 8);
+        print(out, edges.size(), 8);
+        print(out, algorithm.name(), 12);
+        print(out, i, 8);
+        print(out, dist, 8);
+        print(out, t, 8);
+        print(out, counters.settled_nodes, 8);
+        print(out, counters.relaxed_edges, 8);
+        print(out, counters.queue_operations, 8);
+        print(out, sample.instructions, 8);
+        print(out, sample.llc_misses, 8);
+        out << "\n";
+        std::cout << "\n";
+    }
+
+    std::cout << graph_class_name << " " << graph_instance_name << " " << algorithm.name()
+              << " p50 " << percentile(times, 0.5) << " us, p99 " << percentile(times, 0.99) << " us, p999 "
+              << percentile(times, 0.999) << " us" << (perf_counters.available() ? "" : " (no hardware counters)")
+              << std::endl;
+}
+
+void print_header_sssp(std::ostream &out) {
+    print(out, "\"graph class name\"", 28);
+    print(out, "\"graph instance name\"", 20);
+    print(out, "\"n\"", 8);
+    print(out, "\"m\"", 8);
+    print(out, "\"algorithm\"", 12);
+    print(out, "\"delta\"", 8);
+    print(out, "\"number of threads\"", 8);
+    print(out, "\"number of sources\"", 8);
+    print(out, "\"sssp mean (ms)\"", 8);
+    print(out, "\"sssp std (ms)\"", 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+template<class GraphClass, class F>
+void run_benchmark_sssp(std::ostream &out, std::string_view graph_class_name, std::string_view graph_instance_name,
+                        std::string_view algorithm_name, double delta, const GraphClass &graph, std::size_t num_edges,
+                        const std::vector<std::size_t> &sources, F sssp) {
+    std::vector<double> times;
+    for (auto s: sources) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+
+        [[maybe_unused]] const auto &distances = sssp(graph.node(s));
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        times.push_back(duration_ms(t0, t1));
+    }
+
+    print(out, graph_class_name, 28);
+    print(out, graph_instance_name, 20);
+    print(out, graph.numNodes(), 8);
+    print(out, num_edges, 8);
+    print(out, algorithm_name, 12);
+    print(out, delta, 8);
+    print(out, omp_get_max_threads(), 8);
+    print(out, sources.size(), 8);
+    print(out, mean(times), 8);
+    print(out, standard_deviation(times), 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+void print_header_customization(std::ostream &out) {
+    print(out, "\"graph class name\"", 28);
+    print(out, "\"graph instance name\"", 20);
+    print(out, "\"n\"", 8);
+    print(out, "\"m\"", 8);
+    print(out, "\"number of arcs\"", 8);
+    print(out, "\"preprocessing (ms)\"", 8);
+    print(out, "\"number of updates\"", 8);
+    print(out, "\"update (ms)\"", 8);
+    print(out, "\"customization (ms)\"", 8);
+    print(out, "\"number of queries\"", 8);
+    print(out, "\"query mean (ms)\"", 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+template<class Index>
+void run_benchmark_customization(std::ostream &out, std::string_view graph_class_name,
+                                 std::string_view graph_instance_name, std::size_t num_nodes, const EdgeList &edges,
+                                 const EdgeList &updates, const std::vector<std::pair<std::size_t, std::size_t>> &queries) {
+    using CCH = CustomizableContractionHierarchyT<Index>;
+    WeightedGraphSeparatedT<Index> graph(num_nodes, edges);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    CCH cch(graph);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    graph.updateWeights(updates);
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    cch.customize(graph);
+
+    auto t3 = std::chrono::high_resolution_clock::now();
+
+    CustomizableContractionHierarchyHelper<CCH> helper(cch);
+    std::vector<double> query_times;
+    for (const auto &[start, end]: queries) {
+        auto t_query_start = std::chrono::high_resolution_clock::now();
+
+        [[maybe_unused]] auto dist = helper.dijkstra(cch.node(start), cch.node(end));
+
+        auto t_query_end = std::chrono::high_resolution_clock::now();
+        query_times.push_back(duration_ms(t_query_start, t_query_end));
+    }
+
+    print(out, graph_class_name, 28);
+    print(out, graph_instance_name, 20);
+    print(out, num_nodes, 8);
+    print(out, edges.size(), 8);
+    print(out, cch.numArcs(), 8);
+    print(out, duration_ms(t0, t1), 8);
+    print(out, updates.size(), 8);
+    print(out, duration_ms(t1, t2), 8);
+    print(out, duration_ms(t2, t3), 8);
+    print(out, queries.size(), 8);
+    print(out, mean(query_times), 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+// Unlike run_benchmark_customization, the update time includes the customization of the updated cells, the
+// customization time is for all cells.
+template<class Index>
+void run_benchmark_overlay_customization(std::ostream &out, std::string_view graph_class_name,
+                                         std::string_view graph_instance_name, std::size_t num_nodes,
+                                         const EdgeList &edges, const EdgeList &updates,
+                                         const std::vector<std::pair<std::size_t, std::size_t>> &queries) {
+    using Overlay = MultiLevelOverlayT<Index>;
+    WeightedGraphSeparatedT<Index> graph(num_nodes, edges);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    Overlay overlay(graph);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    overlay.updateWeights(updates);
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    graph.updateWeights(updates);
+    overlay.customize(graph);
+
+    auto t3 = std::chrono::high_resolution_clock::now();
+
+    MultiLevelOverlayHelper<Overlay> helper(overlay);
+    std::vector<double> query_times;
+    for (const auto &[start, end]: queries) {
+        auto t_query_start = std::chrono::high_resolution_clock::now();
+
+        [[maybe_unused]] auto dist = helper.dijkstra(overlay.node(start), overlay.node(end));
+
+        auto t_query_end = std::chrono::high_resolution_clock::now();
+        query_times.push_back(duration_ms(t_query_start, t_query_end));
+    }
+
+    print(out, graph_class_name, 28);
+    print(out, graph_instance_name, 20);
+    print(out, num_nodes, 8);
+    print(out, edges.size(), 8);
+    print(out, overlay.numOverlayArcs(), 8);
+    print(out, duration_ms(t0, t1), 8);
+    print(out, updates.size(), 8);
+    print(out, duration_ms(t1, t2), 8);
+    print(out, duration_ms(t2, t3), 8);
+    print(out, queries.size(), 8);
+    print(out, mean(query_times), 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+void print_header_engine(std::ostream &out) {
+    print(out, "\"graph class name\"", 28);
+    print(out, "\"graph instance name\"", 20);
+    print(out, "\"n\"", 8);
+    print(out, "\"m\"", 8);
+    print(out, "\"algorithm\"", 12);
+    print(out, "\"number of threads\"", 8);
+    print(out, "\"number of queries\"", 8);
+    print(out, "\"batch (ms)\"", 8);
+    print(out, "\"p50 (us)\"", 8);
+    print(out, "\"p99 (us)\"", 8);
+    print(out, "\"p999 (us)\"", 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
+template<class GraphClass, class Helper, class Query>
+void run_benchmark_engine(std::ostream &out, std::string_view graph_class_name, std::string_view graph_instance_name,
+                          std::string_view algorithm_name, std::size_t num_nodes, const EdgeList &edges,
+                          std::size_t num_threads, const std::vector<std::pair<std::size_t, std::size_t>> &queries) {
+    GraphClass graph(num_nodes, edges);
+    QueryEngine<GraphClass, Helper, Query> engine(graph, num_threads);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    auto batch = engine.run(queries);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    print(out, graph_class_name, 28);
+    print(out, graph_instance_name, 20);
+    print(out, num_nodes, 8);
+    print(out, edges.size(), 8);
+    print(out, algorithm_name, 12);
+    print(out, engine.numThreads(), 8);
+    print(out, queries.size(), 8);
+    print(out, duration_ms(t0, t1), 8);
+    print(out, batch.p50_us, 8);
+    print(out, batch.p99_us, 8);
+    print(out, batch.p999_us, 8);
+    out << "\n";
+    std::cout << "\n";
+}
+
 std::vector<std::pair<std::size_t, std::size_t>>
 generate_uniform_random_queries(std::size_t num_nodes, std::size_t num_queries, std::size_t seed = 0) {
     std::mt19937_64 gen(seed);
@@ -207,16 +733,81 @@ generate_uniform_random_query(std::size_t num_nodes, std::size_t num_queries, st
 }
 
 
-void run_benchmarks_for_graphs(const std::vector<std::pair<std::string, std::string>> &graph_paths) {
+struct BenchmarkOptions {
+    // number of queries of every section, the number of sources (and targets) for sssp and table
+    std::map<std::string, std::size_t, std::less<>> num_queries{
+            {"batched",       10},
+            {"single",        40},
+            {"profile",       40},
+            {"reordering",    10},
+            {"sssp",          10},
+            {"customization", 1000},
+            {"engine",        1000},
+            {"table",         1000}};
+    // number of repetitions of the batched sections
+    std::size_t num_repetitions{10};
+    // comma separated names of the sections to run, all sections if empty
+    std::string sections{};
+
+    [[nodiscard]] bool runs(std::string_view section) const {
+        if (sections.empty()) return true;
+        std::stringstream ss(sections);
+        std::string name;
+        while (std::getline(ss, name, ',')) {
+            if (name == section) return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::size_t queries(std::string_view section) const {
+        return num_queries.find(section)->second;
+    }
+
+    // Parses "<n>" for all sections or "<section>=<n>[,<section>=<n>...]" for some sections. Returns false on errors.
+    bool parseQueries(const std::string &arg) {
+        auto parse_count = [](const std::string &count, std::size_t &result) {
+            try {
+                std::size_t end;
+                auto value = std::stoll(count, &end);
+                if (end != count.size() || value < 1) return false;
+                result = static_cast<std::size_t>(value);
+                return true;
+            } catch (const std::exception &) {
+                return false;
+            }
+        };
+
+        if (arg.find('=') == std::string::npos) {
+            std::size_t count;
+            if (!parse_count(arg, count)) return false;
+            for (auto &[section, n]: num_queries) n = count;
+            return true;
+        }
+
+        std::stringstream ss(arg);
+        std::string entry;
+        while (std::getline(ss, entry, ',')) {
+            auto split = entry.find('=');
+            auto it = num_queries.find(entry.substr(0, split));
+            if (split == std::string::npos || it == num_queries.end() || !parse_count(entry.substr(split + 1), it->second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void run_benchmarks_for_graphs(const std::vector<std::pair<std::string, std::string>> &graph_paths,
+                               const BenchmarkOptions &options) {
     std::vector<std::tuple<std::string, std::vector<Edge>, std::size_t>> graphs;
     for (const auto &[graph_instance_path, graph_instance_name]: graph_paths) {
-        const auto[edges, num_nodes] = readEdges(graph_instance_path);
+        const auto[edges, num_nodes] = readEdgesParallel(graph_instance_path);
         graphs.emplace_back(graph_instance_name, edges, num_nodes);
     }
 
-    {
-        std::size_t num_construction_queries = 10;
-        std::size_t num_construction_repetitions = 10;
+    if (options.runs("batched")) {
+        std::size_t num_construction_queries = options.queries("batched");
+        std::size_t num_construction_repetitions = options.num_repetitions;
 
         auto file_construction = std::ofstream("benchmark-batched.csv");
         print_header_construction(file_construction);
@@ -238,6 +829,23 @@ void run_benchmarks_for_graphs(const std::vector<std::pair<std::string, std::str
                 run_benchmark_construction<AdjacencyArrayT<uint64_t>>(
                         file_construction, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
 
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, DirectionOptimizingBFS<AdjacencyArrayT<uint32_t>>>(
+                        file_construction, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint64_t>, DirectionOptimizingBFS<AdjacencyArrayT<uint64_t>>>(
+                        file_construction, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, ParallelBFS<AdjacencyArrayT<uint32_t>>>(
+                        file_construction, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint64_t>, ParallelBFS<AdjacencyArrayT<uint64_t>>>(
+                        file_construction, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, BidirectionalBFS<AdjacencyArrayT<uint32_t>>>(
+                        file_construction, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint64_t>, BidirectionalBFS<AdjacencyArrayT<uint64_t>>>(
+                        file_construction, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, BFS<AdjacencyArrayT<uint32_t>>, true>(
+                        file_construction, "AdjacencyArray<u32,par>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint64_t>, BFS<AdjacencyArrayT<uint64_t>>, true>(
+                        file_construction, "AdjacencyArray<u64,par>", graph_instance_name, num_nodes, edges, queries);
+
                 run_benchmark_construction<WeightedGraphPairedT<uint32_t>, Dijkstra<WeightedGraphPairedT<uint32_t>>>(
                         file_construction, "WeightedGraphPaired<u32>", graph_instance_name, num_nodes, edges, queries);
                 run_benchmark_construction<WeightedGraphPairedT<uint64_t>, Dijkstra<WeightedGraphPairedT<uint64_t>>>(
@@ -248,12 +856,74 @@ void run_benchmarks_for_graphs(const std::vector<std::pair<std::string, std::str
                 run_benchmark_construction<WeightedGraphSeparatedT<uint64_t>, Dijkstra<WeightedGraphSeparatedT<uint64_t>>>(
                         file_construction, "WeightedGraphSeparated<u64>", graph_instance_name, num_nodes, edges,
                         queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, Dijkstra<WeightedGraphSeparatedT<uint32_t>, IndexedPriorityQueue<std::size_t, double, std::greater<>>, true>>(
+                        file_construction, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, Dijkstra<WeightedGraphSeparatedT<uint32_t>, RadixHeap<std::size_t>>>(
+                        file_construction, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, Dijkstra<AdjacencyArrayT<uint32_t>, RadixHeap<std::size_t>>>(
+                        file_construction, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, Dijkstra<AdjacencyArrayT<uint32_t>, DialQueue<std::size_t>>>(
+                        file_construction, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, BidirectionalDijkstra<WeightedGraphSeparatedT<uint32_t>>>(
+                        file_construction, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint64_t>, BidirectionalDijkstra<WeightedGraphSeparatedT<uint64_t>>>(
+                        file_construction, "WeightedGraphSeparated<u64>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphPairedT<uint32_t>, Dijkstra<WeightedGraphPairedT<uint32_t>>, true>(
+                        file_construction, "WeightedGraphPaired<u32,par>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphPairedT<uint64_t>, Dijkstra<WeightedGraphPairedT<uint64_t>>, true>(
+                        file_construction, "WeightedGraphPaired<u64,par>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, Dijkstra<WeightedGraphSeparatedT<uint32_t>>, true>(
+                        file_construction, "WeightedGraphSeparated<u32,par>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint64_t>, Dijkstra<WeightedGraphSeparatedT<uint64_t>>, true>(
+                        file_construction, "WeightedGraphSeparated<u64,par>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<CompressedWeightedGraphT<uint32_t>, Dijkstra<CompressedWeightedGraphT<uint32_t>>>(
+                        file_construction, "CompressedWeightedGraph<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<CompressedWeightedGraphT<uint64_t>, Dijkstra<CompressedWeightedGraphT<uint64_t>>>(
+                        file_construction, "CompressedWeightedGraph<u64>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphPairedT<uint32_t, float>, Dijkstra<WeightedGraphPairedT<uint32_t, float>>>(
+                        file_construction, "WeightedGraphPaired<u32,f32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t, float>, Dijkstra<WeightedGraphSeparatedT<uint32_t, float>>>(
+                        file_construction, "WeightedGraphSeparated<u32,f32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                withNarrowestIndex<AdjacencyArrayT>(num_nodes, edges.size(), [&](auto type) {
+                    using Graph = typename decltype(type)::type;
+                    run_benchmark_construction<Graph, BFS<Graph>>(
+                            file_construction, "AdjacencyArray<auto>", graph_instance_name, num_nodes, edges, queries);
+                });
+                withNarrowestTypes<WeightedGraphSeparatedT>(num_nodes, edges, [&](auto type) {
+                    using Graph = typename decltype(type)::type;
+                    run_benchmark_construction<Graph, Dijkstra<Graph>>(
+                            file_construction, "WeightedGraphSeparated<auto>", graph_instance_name, num_nodes, edges,
+                            queries);
+                });
+                run_benchmark_construction<AdjacencyArrayT<uint32_t>, FilteredBFS<AdjacencyArrayT<uint32_t>>>(
+                        file_construction, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, FilteredDijkstra<WeightedGraphSeparatedT<uint32_t>>>(
+                        file_construction, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, ALT<WeightedGraphSeparatedT<uint32_t>>>(
+                        file_construction, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
+                run_benchmark_construction<ContractionHierarchyT<uint32_t>, ContractionHierarchyQuery<ContractionHierarchyT<uint32_t>>>(
+                        file_construction, "ContractionHierarchy<u32>", graph_instance_name, num_nodes, edges,
+                        queries);
             }
         }
     }
 
-    {
-        std::size_t num_queries = 40;
+    if (options.runs("single")) {
+        std::size_t num_queries = options.queries("single");
 
         auto file_runs = std::ofstream("benchmark-single.csv");
         print_header_runs(file_runs);
@@ -274,6 +944,19 @@ void run_benchmarks_for_graphs(const std::vector<std::pair<std::string, std::str
             run_benchmark_runs<AdjacencyArrayT<uint64_t>>(
                     file_runs, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
 
+            run_benchmark_runs<AdjacencyArrayT<uint32_t>, DirectionOptimizingBFS<AdjacencyArrayT<uint32_t>>>(
+                    file_runs, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint64_t>, DirectionOptimizingBFS<AdjacencyArrayT<uint64_t>>>(
+                    file_runs, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint32_t>, ParallelBFS<AdjacencyArrayT<uint32_t>>>(
+                    file_runs, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint64_t>, ParallelBFS<AdjacencyArrayT<uint64_t>>>(
+                    file_runs, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint32_t>, BidirectionalBFS<AdjacencyArrayT<uint32_t>>>(
+                    file_runs, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint64_t>, BidirectionalBFS<AdjacencyArrayT<uint64_t>>>(
+                    file_runs, "AdjacencyArray<u64>", graph_instance_name, num_nodes, edges, queries);
+
             run_benchmark_runs<WeightedGraphPairedT<uint32_t>, Dijkstra<WeightedGraphPairedT<uint32_t>>>(
                     file_runs, "WeightedGraphPaired<u32>", graph_instance_name, num_nodes, edges, queries);
             run_benchmark_runs<WeightedGraphPairedT<uint64_t>, Dijkstra<WeightedGraphPairedT<uint64_t>>>(
@@ -282,18 +965,236 @@ void run_benchmarks_for_graphs(const std::vector<std::pair<std::string, std::str
                     file_runs, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
             run_benchmark_runs<WeightedGraphSeparatedT<uint64_t>, Dijkstra<WeightedGraphSeparatedT<uint64_t>>>(
                     file_runs, "WeightedGraphSeparated<u64>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<WeightedGraphSeparatedT<uint32_t>, Dijkstra<WeightedGraphSeparatedT<uint32_t>, RadixHeap<std::size_t>>>(
+                    file_runs, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint32_t>, Dijkstra<AdjacencyArrayT<uint32_t>, RadixHeap<std::size_t>>>(
+                    file_runs, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint32_t>, Dijkstra<AdjacencyArrayT<uint32_t>, DialQueue<std::size_t>>>(
+                    file_runs, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<WeightedGraphSeparatedT<uint32_t>, BidirectionalDijkstra<WeightedGraphSeparatedT<uint32_t>>>(
+                    file_runs, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<WeightedGraphSeparatedT<uint64_t>, BidirectionalDijkstra<WeightedGraphSeparatedT<uint64_t>>>(
+                    file_runs, "WeightedGraphSeparated<u64>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<CompressedWeightedGraphT<uint32_t>, Dijkstra<CompressedWeightedGraphT<uint32_t>>>(
+                    file_runs, "CompressedWeightedGraph<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<CompressedWeightedGraphT<uint64_t>, Dijkstra<CompressedWeightedGraphT<uint64_t>>>(
+                    file_runs, "CompressedWeightedGraph<u64>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<AdjacencyArrayT<uint32_t>, FilteredBFS<AdjacencyArrayT<uint32_t>>>(
+                    file_runs, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<WeightedGraphSeparatedT<uint32_t>, FilteredDijkstra<WeightedGraphSeparatedT<uint32_t>>>(
+                    file_runs, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<WeightedGraphSeparatedT<uint32_t>, ALT<WeightedGraphSeparatedT<uint32_t>>>(
+                    file_runs, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_runs<ContractionHierarchyT<uint32_t>, ContractionHierarchyQuery<ContractionHierarchyT<uint32_t>>>(
+                    file_runs, "ContractionHierarchy<u32>", graph_instance_name, num_nodes, edges, queries);
+        }
+    }
+
+    if (options.runs("profile")) {
+        std::size_t num_queries = options.queries("profile");
+
+        auto file_profile = std::ofstream("benchmark-profile.csv");
+        print_header_profile(file_profile);
+
+        for (const auto &[graph_instance_name, edges, num_nodes]: graphs) {
+            auto queries = generate_uniform_random_queries(num_nodes, num_queries);
+
+            using Graph = AdjacencyArrayT<uint32_t>;
+            using WeightedGraph = WeightedGraphSeparatedT<uint32_t>;
+            using Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>;
+            run_benchmark_profile<Graph, BFS<Graph>, BFS<CountingGraph<Graph>>>(
+                    file_profile, "AdjacencyArray<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_profile<WeightedGraph, Dijkstra<WeightedGraph>, Dijkstra<CountingGraph<WeightedGraph>, CountingQueue<Queue>>>(
+                    file_profile, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
+            run_benchmark_profile<WeightedGraph, Dijkstra<WeightedGraph, RadixHeap<std::size_t>>, Dijkstra<CountingGraph<WeightedGraph>, CountingQueue<RadixHeap<std::size_t>>>>(
+                    file_profile, "WeightedGraphSeparated<u32>", graph_instance_name, num_nodes, edges, queries);
+        }
+    }
+
+    if (options.runs("reordering")) {
+        std::size_t num_queries = options.queries("reordering");
+        std::size_t num_repetitions = options.num_repetitions;
+
+        auto file_reordering = std::ofstream("benchmark-reordering.csv");
+        print_header_construction(file_reordering);
+
+        for (const auto &[graph_instance_name, edges, num_nodes]: graphs) {
+            auto queries = generate_uniform_random_queries(num_nodes, num_queries);
+
+            for (const auto &[ordering_name, ordering]: {
+                    std::pair{"original", NodeOrdering(identityPermutation(num_nodes))},
+                    std::pair{"bfs", bfsOrdering(num_nodes, edges)},
+                    std::pair{"rcm", reverseCuthillMcKeeOrdering(num_nodes, edges)}}) {
+                auto reordered_name = graph_instance_name + "/" + ordering_name;
+                auto reordered_edges = ordering.relabel(edges);
+                auto reordered_queries = queries;
+                for (auto &[start, end]: reordered_queries) {
+                    start = ordering.toNew(start);
+                    end = ordering.toNew(end);
+                }
+
+                for (std::size_t i = 0; i < num_repetitions; ++i) {
+                    run_benchmark_construction<AdjacencyArrayT<uint32_t>>(
+                            file_reordering, "AdjacencyArray<u32>", reordered_name, num_nodes, reordered_edges,
+                            reordered_queries);
+                    run_benchmark_construction<WeightedGraphSeparatedT<uint32_t>, Dijkstra<WeightedGraphSeparatedT<uint32_t>>>(
+                            file_reordering, "WeightedGraphSeparated<u32>", reordered_name, num_nodes,
+                            reordered_edges, reordered_queries);
+                }
+            }
+        }
+    }
+
+    if (options.runs("sssp")) {
+        std::size_t num_sources = options.queries("sssp");
+
+        auto file_sssp = std::ofstream("benchmark-sssp.csv");
+        print_header_sssp(file_sssp);
+
+        for (const auto &[graph_instance_name, edges, num_nodes]: graphs) {
+            using Graph = WeightedGraphSeparatedT<uint32_t>;
+            Graph graph(num_nodes, edges);
+
+            std::vector<std::size_t> sources;
+            for (const auto &[s, t]: generate_uniform_random_queries(num_nodes, num_sources)) {
+                sources.push_back(s);
+            }
+
+            DijkstraHelper<Graph> dijkstra(graph);
+            run_benchmark_sssp(file_sssp, "WeightedGraphSeparated<u32>", graph_instance_name, "dijkstra", 0.0, graph,
+                               edges.size(), sources, [&](auto s) -> const auto & { return dijkstra.dijkstra(s); });
+
+            DeltaSteppingHelper<Graph> delta_stepping(graph);
+            const auto mean_weight = delta_stepping.delta();
+            for (double factor: {0.25, 0.5, 1.0, 2.0, 4.0, 8.0}) {
+                delta_stepping.setDelta(factor * mean_weight);
+                run_benchmark_sssp(file_sssp, "WeightedGraphSeparated<u32>", graph_instance_name, "delta-stepping",
+                                   delta_stepping.delta(), graph, edges.size(), sources,
+                                   [&](auto s) -> const auto & { return delta_stepping.sssp(s); });
+            }
+        }
+    }
+
+    if (options.runs("customization")) {
+        std::size_t num_queries = options.queries("customization");
+
+        auto file_customization = std::ofstream("benchmark-customization.csv");
+        print_header_customization(file_customization);
+
+        for (const auto &[graph_instance_name, edges, num_nodes]: graphs) {
+            // traffic update: one percent of the edges get up to three times slower
+            std::mt19937_64 gen(0);
+            std::uniform_int_distribution<std::size_t> edge_dist(0, edges.size() - 1);
+            std::uniform_real_distribution<double> factor_dist(1.0, 3.0);
+            EdgeList updates;
+            for (std::size_t i = 0; i < edges.size() / 100; ++i) {
+                auto e = edges[edge_dist(gen)];
+                updates.push_back({e.from, e.to, e.length * factor_dist(gen)});
+            }
+
+            auto queries = generate_uniform_random_queries(num_nodes, num_queries);
+            run_benchmark_customization<uint32_t>(
+                    file_customization, "CustomizableCH<u32>", graph_instance_name, num_nodes, edges, updates,
+                    queries);
+            run_benchmark_overlay_customization<uint32_t>(
+                    file_customization, "MultiLevelOverlay<u32>", graph_instance_name, num_nodes, edges, updates,
+                    queries);
+        }
+    }
+
+    if (options.runs("engine")) {
+        std::size_t num_queries = options.queries("engine");
+
+        auto file_engine = std::ofstream("benchmark-engine.csv");
+        print_header_engine(file_engine);
+
+        for (const auto &[graph_instance_name, edges, num_nodes]: graphs) {
+            auto queries = generate_uniform_random_queries(num_nodes, num_queries);
+
+            for (std::size_t num_threads = 1; num_threads <= std::max(1u, std::thread::hardware_concurrency()); num_threads *= 2) {
+                run_benchmark_engine<WeightedGraphSeparatedT<uint32_t>, DijkstraHelper<WeightedGraphSeparatedT<uint32_t>>, DijkstraQuery>(
+                        file_engine, "WeightedGraphSeparated<u32>", graph_instance_name, "dijkstra", num_nodes, edges,
+                        num_threads, queries);
+                run_benchmark_engine<AdjacencyArrayT<uint32_t>, BFSHelper<AdjacencyArrayT<uint32_t>>, BFSQuery>(
+                        file_engine, "AdjacencyArray<u32>", graph_instance_name, "bfs", num_nodes, edges,
+                        num_threads, queries);
+            }
+        }
+    }
+
+    if (options.runs("table")) {
+        std::size_t num_sources = options.queries("table");
+        std::size_t num_targets = options.queries("table");
+
+        auto file_table = std::ofstream("benchmark-table.csv");
+        print_header_table(file_table);
+
+        for (const auto &[graph_instance_name, edges, num_nodes]: graphs) {
+            std::vector<std::size_t> sources, targets;
+            for (const auto &[s, t]: generate_uniform_random_queries(num_nodes, std::max(num_sources, num_targets))) {
+                if (sources.size() < num_sources) sources.push_back(s);
+                if (targets.size() < num_targets) targets.push_back(t);
+            }
+
+            auto distance_table = [](const auto &graph, const auto &s, const auto &t) {
+                return distanceTable(graph, s, t);
+            };
+            run_benchmark_table<WeightedGraphSeparatedT<uint32_t>>(
+                    file_table, "WeightedGraphSeparated<u32>", graph_instance_name, "dijkstra", num_nodes, edges,
+                    sources, targets, distance_table);
+            run_benchmark_table<ContractionHierarchyT<uint32_t>>(
+                    file_table, "ContractionHierarchy<u32>", graph_instance_name, "ch-buckets", num_nodes, edges,
+                    sources, targets, distance_table);
+
+            run_benchmark_table<AdjacencyArrayT<uint32_t>>(
+                    file_table, "AdjacencyArray<u32>", graph_instance_name, "ms-bfs", num_nodes, edges, sources,
+                    targets, [](const auto &graph, const auto &s, const auto &t) {
+                        return MultiSourceBFSHelper<AdjacencyArrayT<uint32_t>>(graph).bfs(s, t);
+                    });
         }
     }
 }
 
-int main() {
-    const std::vector<std::pair<std::string, std::string>> graphs = {
+// usage: benchmark [-graphs <path>[,<path>...]] [-queries <n> | -queries <section>=<n>[,...]] [-repetitions <n>]
+//                  [-sections <name>[,<name>...]]
+//
+// The instance name of a graph is its file name without extension. Without -graphs the instances in ../data are used.
+// Sections: batched, single, profile, reordering, sssp, customization, engine, table.
+// -queries <n> sets the number of queries of every section, -queries <section>=<n> only those of the given sections.
+// For sssp it is the number of sources, for table the number of sources and of targets.
+int main(int argc, char **argv) {
+    CommandLine cl(argc, argv);
+
+    BenchmarkOptions options;
+    auto queries = cl.strArg("-queries");
+    auto num_repetitions = cl.intArg("-repetitions", static_cast<int>(options.num_repetitions));
+    options.sections = cl.strArg("-sections");
+    auto graph_list = cl.strArg("-graphs");
+
+    if (!cl.report() || (!queries.empty() && !options.parseQueries(queries)) || num_repetitions < 1) {
+        std::cerr << "usage: " << argv[0] << " [-graphs <path>[,<path>...]]"
+                  << " [-queries <n> | -queries <section>=<n>[,...]] [-repetitions <n>]"
+                  << " [-sections <name>[,<name>...]]" << std::endl;
+        return 1;
+    }
+    options.num_repetitions = static_cast<std::size_t>(num_repetitions);
+
+    std::vector<std::pair<std::string, std::string>> graphs = {
             {"../data/netherlands.graph",   "netherlands"},
             {"../data/rgg_n_2_15_s0.graph", "rgg_n_2_15_s0"},
             {"../data/rgg_n_2_18_s0.graph", "rgg_n_2_18_s0"}
     };
 
-    run_benchmarks_for_graphs(graphs);
+    if (!graph_list.empty()) {
+        graphs.clear();
+        std::stringstream ss(graph_list);
+        std::string path;
+        while (std::getline(ss, path, ',')) {
+            graphs.emplace_back(path, std::filesystem::path(path).stem().string());
+        }
+    }
+
+    run_benchmarks_for_graphs(graphs, options);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+
 #include "implementation/edge_list.hpp"
 
 #include "implementation/adj_array.hpp"
@@ -7,9 +15,32 @@
 #include "implementation/node_graph.hpp"
 #include "implementation/weighted_graph_paired.hpp"
 #include "implementation/weighted_graph_separated.hpp"
+#include "implementation/compressed_graph.hpp"
+#include "implementation/binary_graph.hpp"
+#include "implementation/parallel_read_edges.hpp"
+#include "implementation/timestamped_vector.hpp"
+#include "implementation/reordering.hpp"
+#include "implementation/index_selection.hpp"
+#include "implementation/query_engine.hpp"
 
 #include "implementation/bfs.hpp"
+#include "implementation/direction_optimizing_bfs.hpp"
+#include "implementation/parallel_bfs.hpp"
+#include "implementation/bidirectional.hpp"
+#include "implementation/multi_source_bfs.hpp"
 #include "implementation/dijkstra.hpp"
+#include "implementation/delta_stepping.hpp"
+#include "implementation/monotone_queues.hpp"
+#include "implementation/alt.hpp"
+#include "implementation/distance_table.hpp"
+#include "implementation/contraction_hierarchy.hpp"
+#include "implementation/customizable_contraction_hierarchy.hpp"
+#include "implementation/partition.hpp"
+#include "implementation/components.hpp"
+#include "implementation/reverse_graph.hpp"
+#include "implementation/multi_level_overlay.hpp"
+
+#include "utils/query_counters.hpp"
 
 
 struct AdjArr
@@ -20,6 +51,14 @@ struct AdjArr
     }
 };
 
+struct AdjArrPar
+{
+    static auto make(size_t n, const EdgeList& elist)
+    {
+        return AdjacencyArray(parallel_construction,n,elist);
+    }
+};
+
 struct AdjList
 {
     static auto make(size_t n, const EdgeList& elist)
@@ -44,6 +83,14 @@ struct WPair
     }
 };
 
+struct WPairPar
+{
+    static auto make(size_t n, const EdgeList& elist)
+    {
+        return WeightedGraphPaired(parallel_construction,n,elist);
+    }
+};
+
 struct WSep
 {
     static auto make(size_t n, const EdgeList& elist)
@@ -52,6 +99,40 @@ struct WSep
     }
 };
 
+struct Mapped
+{
+    static auto make(size_t n, const EdgeList& elist)
+    {
+        writeBinaryGraph("test_graph.bin", n, elist);
+        return MappedGraph("test_graph.bin");
+    }
+};
+
+struct Mapped32
+{
+    static auto make(size_t n, const EdgeList& elist)
+    {
+        writeBinaryGraph("test_graph_u32.bin", n, elist, 4);
+        return MappedGraphT<uint32_t>("test_graph_u32.bin");
+    }
+};
+
+struct WSepPar
+{
+    static auto make(size_t n, const EdgeList& elist)
+    {
+        return WeightedGraphSeparated(parallel_construction,n,elist);
+    }
+};
+
+struct WComp
+{
+    static auto make(size_t n, const EdgeList& elist)
+    {
+        return CompressedWeightedGraph(n,elist);
+    }
+};
+
 
 
 
@@ -67,7 +148,7 @@ protected:
 
 
 
-using MyTypes = ::testing::Types<AdjArr,AdjList,NGraph,WPair,WSep>;
+using MyTypes = ::testing::Types<AdjArr,AdjArrPar,AdjList,NGraph,WPair,WPairPar,WSep,WSepPar,WComp,Mapped,Mapped32>;
 TYPED_TEST_CASE(GraphClassTest, MyTypes);
 
 TYPED_TEST(GraphClassTest, construction)
@@ -111,7 +192,136 @@ TYPED_TEST(GraphClassTest, bfs_test)
 }
 
 
-using MyTypesWeighted = ::testing::Types<WPair,WSep>;
+TYPED_TEST(GraphClassTest, direction_optimizing_bfs_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto bfsh = BFSHelper<decltype(g)>(g);
+    auto dobfsh = DirectionOptimizingBFSHelper<decltype(g)>(g);
+
+    ASSERT_TRUE(dobfsh.bfs(g.node(4),  g.node(42)) >= g.numNodes());
+    ASSERT_EQ(dobfsh.bfs(g.node(26), g.node(26)), 0);
+    ASSERT_EQ(dobfsh.bfs(g.node( 1), g.node( 2)), 1);
+    ASSERT_EQ(dobfsh.bfs(g.node(18), g.node(32)), 4);
+
+    // default heuristic, only bottom-up steps and only top-down steps
+    for (auto [alpha, beta] : {std::pair{15.0, 18.0}, std::pair{1e-9, 1e18}, std::pair{1e18, 18.0}})
+    {
+        dobfsh.alpha = alpha;
+        dobfsh.beta = beta;
+        for (size_t s = 0; s < n; ++s)
+            for (size_t t = 0; t < n; ++t)
+                ASSERT_EQ(dobfsh.bfs(g.node(s), g.node(t)), bfsh.bfs(g.node(s), g.node(t)));
+    }
+}
+
+
+TYPED_TEST(GraphClassTest, parallel_bfs_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto bfsh = BFSHelper<decltype(g)>(g);
+    auto pbfsh = ParallelBFSHelper<decltype(g)>(g);
+
+    ASSERT_TRUE(pbfsh.bfs(g.node(4),  g.node(42)) >= g.numNodes());
+    ASSERT_EQ(pbfsh.bfs(g.node(26), g.node(26)), 0);
+    ASSERT_EQ(pbfsh.bfs(g.node( 1), g.node( 2)), 1);
+    ASSERT_EQ(pbfsh.bfs(g.node(18), g.node(32)), 4);
+
+    auto max_threads = omp_get_max_threads();
+    for (int num_threads : {1, 4})
+    {
+        omp_set_num_threads(num_threads);
+        for (size_t s = 0; s < n; ++s)
+            for (size_t t = 0; t < n; ++t)
+                ASSERT_EQ(pbfsh.bfs(g.node(s), g.node(t)), bfsh.bfs(g.node(s), g.node(t)));
+    }
+    omp_set_num_threads(max_threads);
+}
+
+
+TYPED_TEST(GraphClassTest, multi_source_bfs_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto bfsh = BFSHelper<decltype(g)>(g);
+    auto msbfsh = MultiSourceBFSHelper<decltype(g)>(g);
+
+    // more than one batch, duplicate sources and targets
+    std::vector<decltype(g.node(0))> sources, targets;
+    for (size_t i = 0; i < 100; ++i) sources.push_back(g.node((i * 7) % n));
+    for (size_t t = 0; t < n; ++t) targets.push_back(g.node(t));
+    targets.push_back(g.node(32));
+
+    auto distances = msbfsh.bfs(sources, targets);
+    ASSERT_EQ(distances.size(), sources.size() * targets.size());
+    for (size_t i = 0; i < sources.size(); ++i)
+        for (size_t j = 0; j < targets.size(); ++j)
+            ASSERT_EQ(distances[i * targets.size() + j], bfsh.bfs(sources[i], targets[j]));
+
+    // early termination with few targets
+    distances = msbfsh.bfs(sources, {g.node(2)});
+    for (size_t i = 0; i < sources.size(); ++i)
+        ASSERT_EQ(distances[i], bfsh.bfs(sources[i], g.node(2)));
+}
+
+
+TYPED_TEST(GraphClassTest, bidirectional_bfs_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto bfsh = BFSHelper<decltype(g)>(g);
+    auto bibfsh = BidirectionalBFSHelper<decltype(g)>(g);
+
+    ASSERT_TRUE(bibfsh.bfs(g.node(4),  g.node(42)) >= g.numNodes());
+    ASSERT_EQ(bibfsh.bfs(g.node(26), g.node(26)), 0);
+    ASSERT_EQ(bibfsh.bfs(g.node( 1), g.node( 2)), 1);
+    ASSERT_EQ(bibfsh.bfs(g.node(18), g.node(32)), 4);
+
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+            ASSERT_EQ(bibfsh.bfs(g.node(s), g.node(t)), bfsh.bfs(g.node(s), g.node(t)));
+}
+
+
+TYPED_TEST(GraphClassTest, bfs_path_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto bfsh = BFSHelper<decltype(g)>(g);
+    auto pbfsh = BFSHelper<decltype(g), true>(g);
+
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+        {
+            auto distance = pbfsh.bfs(g.node(s), g.node(t));
+            ASSERT_EQ(distance, bfsh.bfs(g.node(s), g.node(t)));
+            auto path = pbfsh.path(g.node(t));
+            if (distance >= n)
+            {
+                ASSERT_TRUE(path.empty());
+                continue;
+            }
+            ASSERT_EQ(path.size(), distance + 1);
+            ASSERT_EQ(path.front(), g.node(s));
+            ASSERT_EQ(path.back(), g.node(t));
+            for (size_t i = 0; i + 1 < path.size(); ++i)
+            {
+                bool found = false;
+                for (auto e = g.beginEdges(path[i]); e < g.endEdges(path[i]); ++e)
+                    found |= g.edgeHead(e) == path[i + 1];
+                ASSERT_TRUE(found);
+            }
+        }
+}
+
+
+using MyTypesWeighted = ::testing::Types<WPair,WPairPar,WSep,WSepPar,Mapped,Mapped32>;
 TYPED_TEST_CASE(WeightedGraphClassTest, MyTypesWeighted);
 
 template <class P>
@@ -137,3 +347,1224 @@ TYPED_TEST(WeightedGraphClassTest, dijkstra_test)
     ASSERT_DOUBLE_EQ  (dijh.dijkstra(g.node( 1), g.node( 2)), 1.95864);
     ASSERT_DOUBLE_EQ  (dijh.dijkstra(g.node(18), g.node(32)), 6.0892299999999997);
 }
+
+TYPED_TEST(WeightedGraphClassTest, dijkstra_path_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g), IndexedPriorityQueue<size_t, double, std::greater<>>, true>(g);
+
+    auto path_length = [&](const auto& path)
+    {
+        double length = 0.0;
+        for (size_t i = 0; i + 1 < path.size(); ++i)
+        {
+            double w = std::numeric_limits<double>::infinity();
+            for (auto e = g.beginEdges(path[i]); e < g.endEdges(path[i]); ++e)
+                if (g.edgeHead(e) == path[i + 1]) w = std::min(w, g.edgeWeight(e));
+            length += w;
+        }
+        return length;
+    };
+
+    for (size_t s = 0; s < n; ++s)
+    {
+        for (size_t t = 0; t < n; ++t)
+        {
+            auto distance = dijh.dijkstra(g.node(s), g.node(t));
+            auto path = dijh.path(g.node(t));
+            if (std::isinf(distance))
+            {
+                ASSERT_TRUE(path.empty());
+                continue;
+            }
+            ASSERT_EQ(path.front(), g.node(s));
+            ASSERT_EQ(path.back(), g.node(t));
+            ASSERT_NEAR(path_length(path), distance, 1e-9);
+        }
+
+        const auto& distances = dijh.dijkstra(g.node(s));
+        for (size_t t = 0; t < n; ++t)
+        {
+            auto path = dijh.path(g.node(t));
+            ASSERT_EQ(path.empty(), std::isinf(distances[t]));
+            if (!path.empty())
+            {
+                ASSERT_NEAR(path_length(path), distances[t], 1e-9);
+            }
+        }
+    }
+
+    auto radix = DijkstraHelper<decltype(g), RadixHeap<size_t>, true>(g);
+    auto distance = radix.dijkstra(g.node(18), g.node(32));
+    ASSERT_NEAR(path_length(radix.path(g.node(32))), distance, 1e-9);
+}
+
+TYPED_TEST(WeightedGraphClassTest, bidirectional_dijkstra_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto bidijh = BidirectionalDijkstraHelper<decltype(g)>(g);
+
+    ASSERT_TRUE(bidijh.dijkstra(g.node(4),  g.node(42)) >= 999.);
+    ASSERT_DOUBLE_EQ  (bidijh.dijkstra(g.node(26), g.node(26)), 0.);
+
+    ASSERT_DOUBLE_EQ  (bidijh.dijkstra(g.node( 1), g.node( 2)), 1.95864);
+    ASSERT_DOUBLE_EQ  (bidijh.dijkstra(g.node(18), g.node(32)), 6.0892299999999997);
+
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+            ASSERT_DOUBLE_EQ(bidijh.dijkstra(g.node(s), g.node(t)), dijh.dijkstra(g.node(s), g.node(t)));
+}
+
+TYPED_TEST(WeightedGraphClassTest, radix_heap_dijkstra_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto radixh = DijkstraHelper<decltype(g), RadixHeap<size_t>>(g);
+
+    ASSERT_TRUE(radixh.dijkstra(g.node(4),  g.node(42)) >= 999.);
+    for (size_t s = 0; s < n; ++s)
+    {
+        auto distances = radixh.dijkstra(g.node(s));
+        for (size_t t = 0; t < n; ++t)
+        {
+            ASSERT_DOUBLE_EQ(radixh.dijkstra(g.node(s), g.node(t)), dijh.dijkstra(g.node(s), g.node(t)));
+            ASSERT_DOUBLE_EQ(distances[t], dijh.dijkstra(g.node(s), g.node(t)));
+        }
+    }
+}
+
+TYPED_TEST(WeightedGraphClassTest, one_to_all_dijkstra_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto other = DijkstraHelper<decltype(g)>(g);
+
+    for (size_t s = 0; s < n; ++s)
+    {
+        auto distances = dijh.dijkstra(g.node(s));
+        ASSERT_EQ(distances.size(), n);
+        for (size_t t = 0; t < n; ++t)
+            ASSERT_DOUBLE_EQ(distances[t], other.dijkstra(g.node(s), g.node(t)));
+    }
+}
+
+TYPED_TEST(WeightedGraphClassTest, delta_stepping_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto dsh = DeltaSteppingHelper<decltype(g)>(g);
+    ASSERT_GT(dsh.delta(), 0.0);
+
+    auto max_threads = omp_get_max_threads();
+    for (int num_threads : {1, 4})
+    {
+        omp_set_num_threads(num_threads);
+        // default bucket width, every edge heavy and every edge light
+        for (double delta : {dsh.delta(), 1e-3, 1e9})
+        {
+            dsh.setDelta(delta);
+            for (size_t s = 0; s < n; ++s)
+            {
+                auto expected = dijh.dijkstra(g.node(s));
+                const auto& distances = dsh.sssp(g.node(s));
+                ASSERT_EQ(distances.size(), n);
+                for (size_t t = 0; t < n; ++t)
+                    ASSERT_DOUBLE_EQ(distances[t], expected[t]);
+            }
+        }
+    }
+    omp_set_num_threads(max_threads);
+
+    ASSERT_THROW(dsh.setDelta(0.0), std::runtime_error);
+    ASSERT_THROW(DeltaSteppingHelper<decltype(g)>(g, -1.0), std::runtime_error);
+}
+
+TYPED_TEST(WeightedGraphClassTest, query_counters_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+    using Graph = decltype(g);
+    using Queue = IndexedPriorityQueue<std::size_t, double, std::greater<>>;
+
+    auto dijh = DijkstraHelper<Graph>(g);
+    auto cg = CountingGraph<Graph>(g);
+    auto cdijh = DijkstraHelper<CountingGraph<Graph>, CountingQueue<Queue>>(cg);
+
+    for (size_t s = 0; s < n; ++s)
+    {
+        auto expected = dijh.dijkstra(g.node(s));
+        query_counters = {};
+        auto distances = cdijh.dijkstra(cg.node(s));
+
+        size_t reachable = 0, out_edges = 0;
+        for (size_t t = 0; t < n; ++t)
+        {
+            ASSERT_DOUBLE_EQ(distances[t], expected[t]);
+            if (std::isinf(distances[t])) continue;
+            reachable++;
+            for (auto e = g.beginEdges(g.node(t)); e < g.endEdges(g.node(t)); ++e) out_edges++;
+        }
+        // one-to-all settles every reachable node and relaxes all of its edges
+        ASSERT_EQ(query_counters.settled_nodes, reachable);
+        ASSERT_EQ(query_counters.relaxed_edges, out_edges);
+        // every settled node is pushed and popped at least once
+        ASSERT_GE(query_counters.queue_operations, 2 * reachable);
+    }
+}
+
+TYPED_TEST(WeightedGraphClassTest, distance_table_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+
+    std::vector<decltype(g.node(0))> sources, targets;
+    for (size_t s = 0; s < n; s += 2) sources.push_back(g.node(s));
+    for (size_t t = 0; t < n; t += 3) targets.push_back(g.node(t));
+    targets.push_back(g.node(0));
+
+    auto row = dijh.distances(g.node(18), targets);
+    ASSERT_EQ(row.size(), targets.size());
+    for (size_t j = 0; j < targets.size(); ++j)
+        ASSERT_DOUBLE_EQ(row[j], dijh.dijkstra(g.node(18), targets[j]));
+
+    auto max_threads = omp_get_max_threads();
+    for (int num_threads : {1, 4})
+    {
+        omp_set_num_threads(num_threads);
+        auto table = distanceTable(g, sources, targets);
+        ASSERT_EQ(table.size(), sources.size() * targets.size());
+        for (size_t i = 0; i < sources.size(); ++i)
+            for (size_t j = 0; j < targets.size(); ++j)
+                ASSERT_DOUBLE_EQ(table[i * targets.size() + j], dijh.dijkstra(sources[i], targets[j]));
+    }
+    omp_set_num_threads(max_threads);
+}
+
+TYPED_TEST(WeightedGraphClassTest, alt_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = this->make(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto alth = ALTHelper<decltype(g)>(g, 4);
+
+    ASSERT_EQ(alth.landmarks().size(), 4);
+    ASSERT_TRUE(alth.dijkstra(g.node(4),  g.node(42)) >= 999.);
+    ASSERT_DOUBLE_EQ(alth.dijkstra(g.node(26), g.node(26)), 0.);
+    ASSERT_DOUBLE_EQ(alth.dijkstra(g.node( 1), g.node( 2)), 1.95864);
+    ASSERT_DOUBLE_EQ(alth.dijkstra(g.node(18), g.node(32)), 6.0892299999999997);
+
+    auto max_threads = omp_get_max_threads();
+    for (int num_threads : {1, 4})
+    {
+        omp_set_num_threads(num_threads);
+        alth.updateDistances();
+        for (size_t s = 0; s < n; ++s)
+            for (size_t t = 0; t < n; ++t)
+                ASSERT_DOUBLE_EQ(alth.dijkstra(g.node(s), g.node(t)), dijh.dijkstra(g.node(s), g.node(t)));
+    }
+    omp_set_num_threads(max_threads);
+}
+
+TEST(DialQueueTest, unit_weights)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = AdjacencyArray(n, elist);
+
+    auto bfsh = BFSHelper<decltype(g)>(g);
+    auto dialh = DijkstraHelper<decltype(g), DialQueue<size_t>>(g);
+
+    ASSERT_TRUE(dialh.dijkstra(g.node(4),  g.node(42)) >= 999.);
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+        {
+            auto hops = bfsh.bfs(g.node(s), g.node(t));
+            auto expected = hops >= n ? std::numeric_limits<double>::infinity() : static_cast<double>(hops);
+            ASSERT_DOUBLE_EQ(dialh.dijkstra(g.node(s), g.node(t)), expected);
+        }
+}
+
+TEST(DialQueueTest, integer_weights)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    for (auto &e : elist)
+        e.length = std::round(e.length * 100.);
+    auto g = WeightedGraphSeparated(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto dialh = DijkstraHelper<decltype(g), DialQueue<size_t>>(g);
+
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+            ASSERT_DOUBLE_EQ(dialh.dijkstra(g.node(s), g.node(t)), dijh.dijkstra(g.node(s), g.node(t)));
+}
+
+TEST(CompressedWeightedGraphTest, dijkstra_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = CompressedWeightedGraph(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+
+    // weights are quantized, so distances are only approximately equal
+    ASSERT_TRUE(dijh.dijkstra(g.node(4),  g.node(42)) >= 999.);
+    ASSERT_DOUBLE_EQ(dijh.dijkstra(g.node(26), g.node(26)), 0.);
+    ASSERT_NEAR(dijh.dijkstra(g.node( 1), g.node( 2)), 1.95864, 1e-6);
+    ASSERT_NEAR(dijh.dijkstra(g.node(18), g.node(32)), 6.0892299999999997, 1e-6);
+}
+
+TEST(CompressedWeightedGraphTest, sorted_neighbors)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = CompressedWeightedGraph(n, elist);
+    auto w = WeightedGraphSeparated(n, elist);
+    ASSERT_TRUE(g.fixedPointWeights());
+
+    // documented error bound of fixed point weights
+    double max_weight = 0.;
+    for (const auto& e : elist) max_weight = std::max(max_weight, e.length);
+    const double max_error = max_weight / (2. * std::numeric_limits<uint32_t>::max());
+
+    for (size_t u = 0; u < n; ++u)
+    {
+        std::vector<std::pair<size_t, double>> expected, actual;
+        for (auto e = w.beginEdges(w.node(u)); e < w.endEdges(w.node(u)); ++e)
+            expected.emplace_back(w.nodeId(w.edgeHead(e)), w.edgeWeight(e));
+        for (auto e = g.beginEdges(g.node(u)); e < g.endEdges(g.node(u)); ++e)
+            actual.emplace_back(g.nodeId(g.edgeHead(e)), g.edgeWeight(e));
+        std::sort(expected.begin(), expected.end());
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            ASSERT_EQ(actual[i].first, expected[i].first);
+            ASSERT_NEAR(actual[i].second, expected[i].second, max_error);
+        }
+    }
+}
+
+TEST(CompressedWeightedGraphTest, integral_weights)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    for (auto& e : elist) e.length = std::round(e.length * 100000.);
+    auto shuffled = elist;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(0));
+
+    auto w = WeightedGraphSeparated(n, elist);
+    auto wdijh = DijkstraHelper<decltype(w)>(w);
+    for (const auto& edges : {elist, shuffled})
+    {
+        auto g = CompressedWeightedGraph(n, edges);
+        ASSERT_FALSE(g.fixedPointWeights());
+
+        auto dijh = DijkstraHelper<decltype(g)>(g);
+        for (size_t s = 0; s < n; ++s)
+            for (size_t t = 0; t < n; ++t)
+                ASSERT_EQ(dijh.dijkstra(g.node(s), g.node(t)), wdijh.dijkstra(w.node(s), w.node(t)));
+    }
+}
+
+TEST(MappedGraphTest, header_validation)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    writeBinaryGraph("test_graph_unweighted.bin", n, elist, 8, false);
+
+    auto g = MappedGraph("test_graph_unweighted.bin");
+    ASSERT_EQ(g.numNodes(), n);
+    ASSERT_EQ(g.numEdges(), elist.size());
+    ASSERT_FALSE(g.weighted());
+    ASSERT_DOUBLE_EQ(g.edgeWeight(g.beginEdges(g.node(20))), 1.);
+
+    ASSERT_THROW(MappedGraphT<uint32_t>("test_graph_unweighted.bin"), std::runtime_error);
+    ASSERT_THROW(MappedGraph("../data/test_graph.graph"), std::runtime_error);
+}
+
+TEST(MappedGraphTest, corrupt_files)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    writeBinaryGraph("test_graph_corrupt.bin", n, elist, 8, true);
+
+    std::vector<char> original;
+    {
+        std::ifstream in("test_graph_corrupt.bin", std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    // writes a copy of the file with the 8 byte value at offset replaced
+    auto corrupt = [&](size_t offset, uint64_t value)
+    {
+        auto bytes = original;
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        std::ofstream out("test_graph_corrupt.bin", std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    const size_t num_nodes_offset = offsetof(BinaryGraphHeader, num_nodes);
+    const size_t num_edges_offset = offsetof(BinaryGraphHeader, num_edges);
+    const size_t index_offset = sizeof(BinaryGraphHeader);
+    const size_t heads_offset = index_offset + (n + 1) * sizeof(uint64_t);
+
+    // sizes whose offsets overflow
+    corrupt(num_nodes_offset, std::numeric_limits<uint64_t>::max() / 4);
+    ASSERT_THROW(MappedGraph("test_graph_corrupt.bin"), std::runtime_error);
+    corrupt(num_edges_offset, (std::numeric_limits<uint64_t>::max() >> 3) + 2);
+    ASSERT_THROW(MappedGraph("test_graph_corrupt.bin"), std::runtime_error);
+    // index that does not end at num_edges, index that decreases, head out of range
+    corrupt(index_offset + n * sizeof(uint64_t), elist.size() - 1);
+    ASSERT_THROW(MappedGraph("test_graph_corrupt.bin"), std::runtime_error);
+    // the full scan of the arrays only runs when validation is requested
+    corrupt(index_offset + 5 * sizeof(uint64_t), elist.size());
+    ASSERT_THROW(MappedGraph("test_graph_corrupt.bin", true), std::runtime_error);
+    ASSERT_NO_THROW(MappedGraph("test_graph_corrupt.bin"));
+    corrupt(heads_offset, n);
+    ASSERT_THROW(MappedGraph("test_graph_corrupt.bin", true), std::runtime_error);
+    ASSERT_NO_THROW(MappedGraph("test_graph_corrupt.bin"));
+
+    corrupt(heads_offset, 0);
+    ASSERT_NO_THROW(MappedGraph("test_graph_corrupt.bin", true));
+
+    // the writer rejects edges that do not fit the number of nodes
+    ASSERT_THROW(writeBinaryGraph("test_graph_corrupt.bin", n - 1, elist), std::runtime_error);
+    ASSERT_THROW(writeBinaryGraph("test_graph_corrupt.bin", n, {{0, n, 1.0}}), std::runtime_error);
+}
+
+TEST(ParallelReadEdgesTest, same_as_sequential)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto max_threads = omp_get_max_threads();
+
+    for (int num_threads : {1, 2, 3, 7, 64})
+    {
+        omp_set_num_threads(num_threads);
+        auto [elist_parallel, n_parallel] = readEdgesParallel("../data/test_graph.graph");
+
+        ASSERT_EQ(n_parallel, n);
+        ASSERT_EQ(elist_parallel.size(), elist.size());
+        for (size_t i = 0; i < elist.size(); ++i)
+        {
+            ASSERT_EQ(elist_parallel[i].from, elist[i].from);
+            ASSERT_EQ(elist_parallel[i].to, elist[i].to);
+            ASSERT_DOUBLE_EQ(elist_parallel[i].length, elist[i].length);
+        }
+    }
+    omp_set_num_threads(max_threads);
+
+    ASSERT_THROW(readEdgesParallel("does_not_exist.graph"), std::runtime_error);
+}
+
+TEST(ParallelCSRTest, inclusive_scan)
+{
+    for (size_t n : {0, 1, 2, 5, 1000, 12345})
+    {
+        std::vector<size_t> data(n), expected(n);
+        for (size_t i = 0; i < n; ++i) data[i] = (i * 7) % 13;
+        std::inclusive_scan(data.begin(), data.end(), expected.begin());
+
+        parallel_csr::inclusiveScan(data.data(), data.size());
+        ASSERT_EQ(data, expected);
+    }
+}
+
+TEST(ContractionHierarchyTest, dijkstra_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+    auto ch = ContractionHierarchyT<uint32_t>(n, elist);
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto chh = ContractionHierarchyHelper<decltype(ch)>(ch);
+
+    ASSERT_TRUE(chh.dijkstra(ch.node(4),  ch.node(42)) >= 999.);
+    ASSERT_DOUBLE_EQ(chh.dijkstra(ch.node(26), ch.node(26)), 0.);
+    ASSERT_DOUBLE_EQ(chh.dijkstra(ch.node( 1), ch.node( 2)), 1.95864);
+    ASSERT_DOUBLE_EQ(chh.dijkstra(ch.node(18), ch.node(32)), 6.0892299999999997);
+
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+            ASSERT_DOUBLE_EQ(chh.dijkstra(ch.node(s), ch.node(t)), dijh.dijkstra(g.node(s), g.node(t)));
+}
+
+TEST(ContractionHierarchyTest, distance_table_test)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+    auto ch = ContractionHierarchyT<uint32_t>(n, elist);
+
+    std::vector<uint32_t> nodes;
+    for (size_t v = 0; v < n; ++v) nodes.push_back(ch.node(v));
+
+    auto max_threads = omp_get_max_threads();
+    for (int num_threads : {1, 4})
+    {
+        omp_set_num_threads(num_threads);
+        auto table = distanceTable(ch, nodes, nodes);
+        auto expected = distanceTable(g, std::vector<size_t>(nodes.begin(), nodes.end()),
+                                      std::vector<size_t>(nodes.begin(), nodes.end()));
+        ASSERT_EQ(table.size(), expected.size());
+        for (size_t i = 0; i < table.size(); ++i)
+            ASSERT_DOUBLE_EQ(table[i], expected[i]);
+    }
+    omp_set_num_threads(max_threads);
+}
+
+TEST(ContractionHierarchyTest, grid_graph)
+{
+    // road-like grid with random weights, some one-way streets and some long random edges
+    const size_t k = 20, n = k * k;
+    std::mt19937_64 gen(0);
+    std::uniform_int_distribution<size_t> node_dist(0, n - 1);
+    std::uniform_real_distribution<double> weight_dist(0.1, 10.0);
+    std::bernoulli_distribution one_way(0.1);
+
+    EdgeList elist;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < k; ++j)
+            for (auto [u, v] : {std::pair{i * k + j, i * k + j + 1}, std::pair{i * k + j, (i + 1) * k + j}})
+            {
+                if ((v == i * k + j + 1 && j + 1 == k) || v >= n) continue;
+                auto w = weight_dist(gen);
+                elist.push_back({u, v, w});
+                if (!one_way(gen)) elist.push_back({v, u, w});
+            }
+    for (size_t i = 0; i < 20; ++i)
+        elist.push_back({node_dist(gen), node_dist(gen), 10 * weight_dist(gen)});
+
+    auto g = WeightedGraphSeparated(n, elist);
+    auto ch = ContractionHierarchy(n, elist);
+
+    // upward graph and reversed downward graph only lead to nodes of higher rank
+    for (const auto& h : {ch.upwardGraph(), ch.downwardGraph()})
+        for (size_t u = 0; u < n; ++u)
+            for (auto e = h.beginEdges(h.node(u)); e < h.endEdges(h.node(u)); ++e)
+                ASSERT_LT(ch.rank(u), ch.rank(h.edgeHead(e)));
+
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto chh = ContractionHierarchyHelper<decltype(ch)>(ch);
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        auto s = node_dist(gen), t = node_dist(gen);
+        auto expected = dijh.dijkstra(g.node(s), g.node(t));
+        if (std::isinf(expected))
+            ASSERT_TRUE(std::isinf(chh.dijkstra(ch.node(s), ch.node(t))));
+        else
+            ASSERT_NEAR(chh.dijkstra(ch.node(s), ch.node(t)), expected, 1e-9);
+    }
+}
+
+TEST(WeightedGraphSeparatedTest, update_weights)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+
+    auto e = g.findEdge(g.node(elist[0].from), g.node(elist[0].to));
+    ASSERT_NE(e, g.endEdges(g.node(elist[0].from)));
+    g.setEdgeWeight(e, 42.0);
+    ASSERT_EQ(g.edgeWeight(e), 42.0);
+
+    g.updateWeights(EdgeList{{elist[1].from, elist[1].to, 7.0}, {elist[1].from, elist[1].to, 8.0}});
+    ASSERT_EQ(g.edgeWeight(g.findEdge(g.node(elist[1].from), g.node(elist[1].to))), 8.0);
+    ASSERT_EQ(g.edgeHead(g.findEdge(g.node(elist[1].from), g.node(elist[1].to))), elist[1].to);
+
+    ASSERT_EQ(g.findEdge(g.node(4), g.node(4)), g.endEdges(g.node(4)));
+    ASSERT_THROW(g.updateWeights(EdgeList{{4, 4, 1.0}}), std::runtime_error);
+    ASSERT_THROW(g.updateWeights(EdgeList{{n, 0, 1.0}}), std::runtime_error);
+}
+
+TEST(CustomizableContractionHierarchyTest, customize_after_updates)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+    auto cch = CustomizableContractionHierarchy(g);
+    auto cchh = CustomizableContractionHierarchyHelper<decltype(cch)>(cch);
+
+    std::mt19937_64 gen(0);
+    std::uniform_int_distribution<size_t> edge_dist(0, elist.size() - 1);
+    std::uniform_real_distribution<double> weight_dist(0.1, 10.0);
+
+    for (int round = 0; round < 3; ++round)
+    {
+        auto dijh = DijkstraHelper<decltype(g)>(g);
+        for (size_t s = 0; s < n; ++s)
+            for (size_t t = 0; t < n; ++t)
+            {
+                auto expected = dijh.dijkstra(g.node(s), g.node(t));
+                if (std::isinf(expected))
+                    ASSERT_TRUE(std::isinf(cchh.dijkstra(cch.node(s), cch.node(t))));
+                else
+                    ASSERT_NEAR(cchh.dijkstra(cch.node(s), cch.node(t)), expected, 1e-9);
+            }
+
+        EdgeList updates;
+        for (size_t i = 0; i < 20; ++i)
+        {
+            auto e = elist[edge_dist(gen)];
+            updates.push_back({e.from, e.to, weight_dist(gen)});
+        }
+        g.updateWeights(updates);
+        cch.customize(g);
+    }
+
+    ASSERT_THROW(cch.customize(WeightedGraphSeparated(n, EdgeList{{0, 1, 1.0}})), std::runtime_error);
+}
+
+TEST(CustomizableContractionHierarchyTest, grid_graph)
+{
+    const size_t k = 20, n = k * k;
+    std::mt19937_64 gen(0);
+    std::uniform_int_distribution<size_t> node_dist(0, n - 1);
+    std::uniform_real_distribution<double> weight_dist(0.1, 10.0);
+    std::bernoulli_distribution one_way(0.1);
+
+    EdgeList elist;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < k; ++j)
+            for (auto [u, v] : {std::pair{i * k + j, i * k + j + 1}, std::pair{i * k + j, (i + 1) * k + j}})
+            {
+                if ((v == i * k + j + 1 && j + 1 == k) || v >= n) continue;
+                auto w = weight_dist(gen);
+                elist.push_back({u, v, w});
+                if (!one_way(gen)) elist.push_back({v, u, w});
+            }
+    for (size_t i = 0; i < 20; ++i)
+        elist.push_back({node_dist(gen), node_dist(gen), 10 * weight_dist(gen)});
+
+    auto g = WeightedGraphSeparatedT<uint32_t>(n, elist);
+    auto cch = CustomizableContractionHierarchyT<uint32_t>(g);
+
+    // all arcs lead to ancestors in the elimination tree
+    for (size_t r = 0; r < n; ++r)
+        for (auto a = cch.beginArcs(r); a < cch.endArcs(r); ++a)
+        {
+            auto x = cch.parent(r);
+            while (x != cch.arcHead(a) && x != n) x = cch.parent(x);
+            ASSERT_EQ(x, cch.arcHead(a));
+        }
+
+    auto cchh = CustomizableContractionHierarchyHelper<decltype(cch)>(cch);
+    for (int round = 0; round < 2; ++round)
+    {
+        auto dijh = DijkstraHelper<decltype(g)>(g);
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            auto s = node_dist(gen), t = node_dist(gen);
+            auto expected = dijh.dijkstra(g.node(s), g.node(t));
+            if (std::isinf(expected))
+                ASSERT_TRUE(std::isinf(cchh.dijkstra(cch.node(s), cch.node(t))));
+            else
+                ASSERT_NEAR(cchh.dijkstra(cch.node(s), cch.node(t)), expected, 1e-9);
+        }
+
+        for (size_t u = 0; u < n; ++u)
+            for (auto e = g.beginEdges(g.node(u)); e < g.endEdges(g.node(u)); ++e)
+                g.setEdgeWeight(e, g.edgeWeight(e) * (1.0 + weight_dist(gen)));
+        cch.customize(g);
+    }
+}
+
+TEST(NestedDissectionTest, reduces_fill)
+{
+    // grid graph with shuffled node ids
+    const size_t k = 30, n = k * k;
+    std::vector<size_t> shuffled(n);
+    std::iota(shuffled.begin(), shuffled.end(), 0);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(0));
+
+    EdgeList elist;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < k; ++j)
+        {
+            if (j + 1 < k) elist.push_back({shuffled[i * k + j], shuffled[i * k + j + 1], 1.});
+            if (i + 1 < k) elist.push_back({shuffled[i * k + j], shuffled[(i + 1) * k + j], 1.});
+        }
+    // two components
+    elist.push_back({n, n + 1, 1.});
+    elist.push_back({n + 1, n + 2, 1.});
+
+    auto ordering = nestedDissectionOrdering(n + 3, elist);
+    ASSERT_EQ(ordering.size(), n + 3);
+
+    auto g = WeightedGraphSeparated(n + 3, elist);
+    auto nested = CustomizableContractionHierarchy(g, ordering);
+    auto identity = CustomizableContractionHierarchy(g, NodeOrdering(identityPermutation(n + 3)));
+    ASSERT_LT(2 * nested.numArcs(), identity.numArcs());
+}
+
+TEST(MultilevelPartitionTest, nested_cells)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    // isolated nodes at the end
+    auto p = multilevelPartition(n + 5, elist, {4, 16});
+    ASSERT_EQ(p.numLevels(), 2);
+
+    for (size_t l = 0; l < p.numLevels(); ++l)
+    {
+        std::vector<size_t> size(p.num_cells[l], 0);
+        for (size_t v = 0; v < n + 5; ++v)
+        {
+            ASSERT_LT(p.cell[l][v], p.num_cells[l]);
+            size[p.cell[l][v]]++;
+        }
+        for (auto s : size)
+        {
+            ASSERT_GT(s, 0);
+            ASSERT_LE(s, l == 0 ? 4 : 16);
+        }
+    }
+
+    // every cell of level 0 lies in one cell of level 1
+    std::vector<size_t> parent(p.num_cells[0], p.num_cells[1]);
+    for (size_t v = 0; v < n + 5; ++v)
+    {
+        auto& c = parent[p.cell[0][v]];
+        if (c == p.num_cells[1]) c = p.cell[1][v];
+        ASSERT_EQ(c, p.cell[1][v]);
+    }
+
+    ASSERT_THROW(multilevelPartition(n, elist, {16, 16}), std::runtime_error);
+    ASSERT_THROW(multilevelPartition(n, elist, {0}), std::runtime_error);
+}
+
+TEST(MultiLevelOverlayTest, queries_after_updates)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+
+    std::mt19937_64 gen(0);
+    std::uniform_int_distribution<size_t> edge_dist(0, elist.size() - 1);
+    std::uniform_real_distribution<double> weight_dist(0.1, 10.0);
+
+    for (auto cell_sizes : {std::vector<size_t>{4, 16}, std::vector<size_t>{2, 8, 32}, std::vector<size_t>{1000}})
+    {
+        auto overlay = MultiLevelOverlay(g, cell_sizes);
+        auto full = MultiLevelOverlay(g, cell_sizes);
+        ASSERT_EQ(overlay.numLevels(), cell_sizes.size());
+        auto mh = MultiLevelOverlayHelper<decltype(overlay)>(overlay);
+        auto fh = MultiLevelOverlayHelper<decltype(full)>(full);
+
+        for (int round = 0; round < 3; ++round)
+        {
+            auto dijh = DijkstraHelper<decltype(g)>(g);
+            for (size_t s = 0; s < n; ++s)
+                for (size_t t = 0; t < n; ++t)
+                {
+                    auto expected = dijh.dijkstra(g.node(s), g.node(t));
+                    if (std::isinf(expected))
+                    {
+                        ASSERT_TRUE(std::isinf(mh.dijkstra(overlay.node(s), overlay.node(t))));
+                    }
+                    else
+                    {
+                        ASSERT_NEAR(mh.dijkstra(overlay.node(s), overlay.node(t)), expected, 1e-9);
+                        ASSERT_NEAR(fh.dijkstra(full.node(s), full.node(t)), expected, 1e-9);
+                    }
+                }
+
+            // local customization of the updated cells and full customization agree
+            EdgeList updates;
+            for (size_t i = 0; i < 10; ++i)
+            {
+                auto e = elist[edge_dist(gen)];
+                updates.push_back({e.from, e.to, weight_dist(gen)});
+            }
+            g.updateWeights(updates);
+            overlay.updateWeights(updates);
+            full.customize(g);
+        }
+    }
+
+    auto overlay = MultiLevelOverlay(g, {4, 16});
+    ASSERT_THROW(overlay.updateWeights(EdgeList{{n, 0, 1.0}}), std::runtime_error);
+    ASSERT_THROW(overlay.customize(WeightedGraphSeparated(n, EdgeList{{0, 1, 1.0}})), std::runtime_error);
+}
+
+TEST(MultiLevelOverlayTest, grid_graph)
+{
+    const size_t k = 30, n = k * k;
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<size_t> node_dist(0, n - 1);
+    std::uniform_real_distribution<double> weight_dist(0.1, 10.0);
+    std::bernoulli_distribution one_way(0.1);
+
+    EdgeList elist;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < k; ++j)
+        {
+            std::vector<std::pair<size_t, size_t>> neighbors;
+            if (j + 1 < k) neighbors.emplace_back(i * k + j, i * k + j + 1);
+            if (i + 1 < k) neighbors.emplace_back(i * k + j, (i + 1) * k + j);
+            for (auto [u, v] : neighbors)
+            {
+                auto w = weight_dist(gen);
+                elist.push_back({u, v, w});
+                if (!one_way(gen)) elist.push_back({v, u, w});
+            }
+        }
+
+    auto g = WeightedGraphSeparatedT<uint32_t>(n, elist);
+    auto overlay = MultiLevelOverlayT<uint32_t>(g, {16, 64, 256});
+
+    // boundary nodes have an edge into another cell of their level
+    for (size_t l = 0; l < overlay.numLevels(); ++l)
+        for (size_t c = 0; c < overlay.numCells(l); ++c)
+            for (size_t i = 0; i < overlay.numBoundaryNodes(l, c); ++i)
+            {
+                auto v = overlay.boundaryNode(l, c, i);
+                ASSERT_EQ(overlay.cell(l, v), c);
+                ASSERT_EQ(overlay.boundaryIndex(l, v), i);
+            }
+
+    auto mh = MultiLevelOverlayHelper<decltype(overlay)>(overlay);
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        auto s = node_dist(gen), t = node_dist(gen);
+        auto expected = dijh.dijkstra(g.node(s), g.node(t));
+        if (std::isinf(expected))
+            ASSERT_TRUE(std::isinf(mh.dijkstra(overlay.node(s), overlay.node(t))));
+        else
+            ASSERT_NEAR(mh.dijkstra(overlay.node(s), overlay.node(t)), expected, 1e-9);
+    }
+}
+
+// nodes reachable from start, following in-edges if backward
+std::vector<bool> reachableNodes(const AdjacencyArray& g, const AdjacencyArray& reverse, size_t start, bool backward)
+{
+    const auto& graph = backward ? reverse : g;
+    std::vector<bool> reached(graph.numNodes(), false);
+    std::vector<size_t> stack{start};
+    reached[start] = true;
+    while (!stack.empty())
+    {
+        auto u = graph.node(stack.back());
+        stack.pop_back();
+        for (auto e = graph.beginEdges(u); e < graph.endEdges(u); ++e)
+        {
+            auto v = graph.nodeId(graph.edgeHead(e));
+            if (!reached[v])
+            {
+                reached[v] = true;
+                stack.push_back(v);
+            }
+        }
+    }
+    return reached;
+}
+
+void checkComponents(size_t n, const EdgeList& elist)
+{
+    auto g = AdjacencyArray(n, elist);
+    auto reverse = AdjacencyArray(n, reversedEdgeList(g));
+    auto strong = strongComponents(g);
+    auto weak = weakComponents(g);
+    ASSERT_EQ(strong.component.size(), n);
+    ASSERT_EQ(weak.component.size(), n);
+
+    // topological order and consistent weak components along every edge
+    for (const auto& e : elist)
+    {
+        ASSERT_LE(strong.component[e.from], strong.component[e.to]);
+        ASSERT_EQ(weak.component[e.from], weak.component[e.to]);
+    }
+
+    // a strong component is the intersection of the forward and backward reachable nodes of each of its nodes
+    std::vector<bool> checked(strong.num_components, false);
+    for (size_t v = 0; v < n; ++v)
+    {
+        ASSERT_LT(strong.component[v], strong.num_components);
+        if (checked[strong.component[v]]) continue;
+        checked[strong.component[v]] = true;
+        auto forward = reachableNodes(g, reverse, v, false);
+        auto backward = reachableNodes(g, reverse, v, true);
+        for (size_t u = 0; u < n; ++u)
+            ASSERT_EQ(forward[u] && backward[u], strong.component[u] == strong.component[v]);
+    }
+    for (auto c : checked) ASSERT_TRUE(c);
+
+    // as many weak components as components of the undirected graph
+    auto both = elist;
+    for (const auto& e : elist) both.push_back({e.to, e.from, e.length});
+    auto undirected = AdjacencyArray(n, both);
+    std::vector<bool> seen(n, false);
+    size_t num_weak = 0;
+    for (size_t v = 0; v < n; ++v)
+    {
+        if (seen[v]) continue;
+        num_weak++;
+        auto reached = reachableNodes(undirected, undirected, v, false);
+        for (size_t u = 0; u < n; ++u)
+            if (reached[u]) seen[u] = true;
+    }
+    ASSERT_EQ(weak.num_components, num_weak);
+}
+
+TEST(ComponentsTest, test_graph)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    // isolated nodes and a cycle of new nodes with a tail
+    elist.push_back({n + 2, n + 3, 1.});
+    elist.push_back({n + 3, n + 4, 1.});
+    elist.push_back({n + 4, n + 2, 1.});
+    elist.push_back({n + 4, n + 5, 1.});
+    checkComponents(n + 6, elist);
+}
+
+TEST(ComponentsTest, random_graphs)
+{
+    auto max_threads = omp_get_max_threads();
+    for (int num_threads : {1, 4})
+    {
+        omp_set_num_threads(num_threads);
+        for (size_t seed = 0; seed < 3; ++seed)
+        {
+            const size_t n = 1000;
+            std::mt19937_64 gen(seed);
+            std::uniform_int_distribution<size_t> node_dist(0, n - 1);
+            EdgeList elist;
+            for (size_t i = 0; i < n + 300 * seed; ++i)
+                elist.push_back({node_dist(gen), node_dist(gen), 1.});
+            checkComponents(n, elist);
+        }
+    }
+    omp_set_num_threads(max_threads);
+}
+
+TEST(ComponentsTest, chain_of_cycles)
+{
+    // 2-cycles whose ids decrease along the chain, a coloring round completes only one of them
+    auto chain = [](size_t num_cycles)
+    {
+        EdgeList elist;
+        for (size_t i = 0; i < num_cycles; ++i)
+        {
+            elist.push_back({2 * i, 2 * i + 1, 1.});
+            elist.push_back({2 * i + 1, 2 * i, 1.});
+            if (i > 0) elist.push_back({2 * i, 2 * i - 2, 1.});
+        }
+        return elist;
+    };
+    checkComponents(2000, chain(1000));
+
+    const size_t num_cycles = 100000;
+    auto g = AdjacencyArray(2 * num_cycles, chain(num_cycles));
+    auto strong = strongComponents(g);
+    ASSERT_EQ(strong.num_components, num_cycles);
+    for (size_t i = 0; i < num_cycles; ++i)
+    {
+        ASSERT_EQ(strong.component[2 * i], strong.component[2 * i + 1]);
+        ASSERT_EQ(strong.component[2 * i], num_cycles - 1 - i);
+    }
+}
+
+TEST(ComponentsTest, filtered_queries)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto wg = WeightedGraphSeparated(n, elist);
+    auto ag = AdjacencyArray(n, elist);
+    auto wcomponents = ComponentIndex(wg);
+    auto acomponents = ComponentIndex(ag);
+
+    auto dijh = DijkstraHelper<decltype(wg)>(wg);
+    auto fdijh = DijkstraHelper<decltype(wg)>(wg);
+    fdijh.setComponents(&wcomponents);
+    auto bfsh = BFSHelper<decltype(ag)>(ag);
+    auto fbfsh = BFSHelper<decltype(ag)>(ag);
+    fbfsh.setComponents(&acomponents);
+
+    size_t filtered = 0;
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+        {
+            auto distance = dijh.dijkstra(wg.node(s), wg.node(t));
+            ASSERT_EQ(fdijh.dijkstra(wg.node(s), wg.node(t)), distance);
+            ASSERT_EQ(fbfsh.bfs(ag.node(s), ag.node(t)), bfsh.bfs(ag.node(s), ag.node(t)));
+            if (!wcomponents.mayReach(s, t))
+            {
+                ASSERT_TRUE(std::isinf(distance));
+                filtered++;
+            }
+        }
+    // (4, 42) is unreachable
+    ASSERT_FALSE(wcomponents.mayReach(4, 42));
+    ASSERT_GT(filtered, 0);
+}
+
+TEST(TimestampedVectorTest, assign_resets_entries)
+{
+    TimestampedVector<double> v;
+    v.assign(10, 1.5);
+    ASSERT_EQ(v.size(), 10);
+    v.set(3, 7.0);
+    ASSERT_DOUBLE_EQ(v[3], 7.0);
+    ASSERT_DOUBLE_EQ(v[4], 1.5);
+
+    v.assign(20, -1.0);
+    ASSERT_EQ(v.size(), 20);
+    for (size_t i = 0; i < v.size(); ++i)
+        ASSERT_DOUBLE_EQ(v[i], -1.0);
+    v.set(15, 2.0);
+    ASSERT_DOUBLE_EQ(v[15], 2.0);
+}
+
+TEST(TimestampedVectorTest, flags)
+{
+    TimestampedVector<bool> v;
+    v.assign(10, false);
+    v.set(3, true);
+    ASSERT_TRUE(v[3]);
+    ASSERT_FALSE(v[4]);
+    v.set(3, false);
+    ASSERT_FALSE(v[3]);
+
+    v.assign(10, true);
+    v.set(2, false);
+    ASSERT_FALSE(v[2]);
+    ASSERT_TRUE(v[3]);
+
+    // stamps wrap around after 65535 assigns
+    for (size_t i = 0; i < 70000; ++i)
+    {
+        v.assign(10, false);
+        ASSERT_FALSE(v[i % 10]);
+        v.set(i % 10, true);
+        ASSERT_TRUE(v[i % 10]);
+    }
+}
+
+TEST(IndexedPriorityQueueTest, clear)
+{
+    IndexedPriorityQueue<size_t, double, std::greater<>> queue(100);
+    for (size_t i = 0; i < 100; i += 3)
+        queue.push(i, static_cast<double>(100 - i));
+    queue.pop();
+    queue.clear();
+    ASSERT_TRUE(queue.empty());
+    for (size_t i = 0; i < 100; ++i)
+        ASSERT_FALSE(queue.hasKey(i));
+
+    queue.push(5, 1.0);
+    queue.push(7, 0.5);
+    ASSERT_EQ(queue.pop().first, 7);
+    ASSERT_EQ(queue.pop().first, 5);
+}
+
+TEST(ReorderingTest, distances_are_preserved)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+
+    for (const auto& ordering : {bfsOrdering(n, elist), reverseCuthillMcKeeOrdering(n, elist)})
+    {
+        ASSERT_EQ(ordering.size(), n);
+        for (size_t v = 0; v < n; ++v)
+            ASSERT_EQ(ordering.toOld(ordering.toNew(v)), v);
+
+        auto h = WeightedGraphSeparated(n, ordering.relabel(elist));
+        auto dijh_reordered = DijkstraHelper<decltype(h)>(h);
+        for (size_t s = 0; s < n; ++s)
+            for (size_t t = 0; t < n; ++t)
+                ASSERT_DOUBLE_EQ(dijh_reordered.dijkstra(h.node(ordering.toNew(s)), h.node(ordering.toNew(t))),
+                                 dijh.dijkstra(g.node(s), g.node(t)));
+    }
+
+    ASSERT_THROW(NodeOrdering({0, 2, 2}), std::runtime_error);
+}
+
+TEST(ReorderingTest, reverse_cuthill_mckee_reduces_bandwidth)
+{
+    // grid graph with shuffled node ids
+    const size_t k = 30, n = k * k;
+    std::vector<size_t> shuffled(n);
+    std::iota(shuffled.begin(), shuffled.end(), 0);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(0));
+
+    EdgeList elist;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < k; ++j)
+        {
+            if (j + 1 < k) elist.push_back({shuffled[i * k + j], shuffled[i * k + j + 1], 1.});
+            if (i + 1 < k) elist.push_back({shuffled[i * k + j], shuffled[(i + 1) * k + j], 1.});
+        }
+
+    auto bandwidth = [](const EdgeList& edges)
+    {
+        size_t b = 0;
+        for (const auto& e : edges) b = std::max(b, e.from > e.to ? e.from - e.to : e.to - e.from);
+        return b;
+    };
+
+    ASSERT_GT(bandwidth(elist), 10 * k);
+    ASSERT_LE(bandwidth(reverseCuthillMcKeeOrdering(n, elist).relabel(elist)), 2 * k);
+    ASSERT_LE(bandwidth(bfsOrdering(n, elist).relabel(elist)), 2 * k);
+}
+
+TEST(IndexSelectionTest, compact_edges)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto [compact, n_compact] = readEdgesParallel<EdgeT<uint32_t, float>>("../data/test_graph.graph");
+    ASSERT_EQ(n_compact, n);
+    ASSERT_EQ(compact.size(), elist.size());
+
+    auto g = WeightedGraphSeparated(n, elist);
+    auto h = WeightedGraphSeparatedT<uint32_t, float>(n, compact);
+    auto p = WeightedGraphPairedT<uint32_t, float>(n, compactEdges<uint32_t, float>(elist));
+    auto a = AdjacencyArray(n, elist);
+    auto b = AdjacencyArrayT<uint32_t>(n, compact);
+
+    auto dijh_g = DijkstraHelper<decltype(g)>(g);
+    auto dijh_h = DijkstraHelper<decltype(h)>(h);
+    auto dijh_p = DijkstraHelper<decltype(p)>(p);
+    auto bfsh_a = BFSHelper<decltype(a)>(a);
+    auto bfsh_b = BFSHelper<decltype(b)>(b);
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+        {
+            auto d = dijh_g.dijkstra(g.node(s), g.node(t));
+            if (d == std::numeric_limits<double>::infinity())
+            {
+                ASSERT_EQ(dijh_h.dijkstra(h.node(s), h.node(t)), d);
+                ASSERT_EQ(dijh_p.dijkstra(p.node(s), p.node(t)), d);
+            }
+            else
+            {
+                ASSERT_NEAR(dijh_h.dijkstra(h.node(s), h.node(t)), d, 1e-6 * d);
+                ASSERT_NEAR(dijh_p.dijkstra(p.node(s), p.node(t)), d, 1e-6 * d);
+            }
+            ASSERT_EQ(bfsh_b.bfs(b.node(s), b.node(t)), bfsh_a.bfs(a.node(s), a.node(t)));
+        }
+}
+
+TEST(IndexSelectionTest, narrowest_types)
+{
+    ASSERT_TRUE(fitsIndex<uint8_t>(255, 255));
+    ASSERT_FALSE(fitsIndex<uint8_t>(256, 0));
+    ASSERT_FALSE(fitsIndex<uint8_t>(0, 256));
+    ASSERT_FALSE(fitsIndex<uint32_t>(size_t{1} << 32, 0));
+
+    EdgeList integer_weights = {{0, 1, 1.}, {1, 2, 16777216.}};
+    EdgeList real_weights = {{0, 1, 0.1}, {1, 2, 2.}};
+    ASSERT_TRUE(weightsFitFloat(integer_weights));
+    ASSERT_FALSE(weightsFitFloat(real_weights));
+    ASSERT_TRUE(weightsFitFloat(real_weights, 1e-6));
+    ASSERT_FALSE(weightsFitFloat(EdgeList{{0, 1, 1e300}}, 1.0));
+
+    auto index_width = [](size_t n, size_t m)
+    {
+        return withNarrowestIndex<AdjacencyArrayT>(n, m, [](auto type)
+        {
+            return sizeof(typename decltype(type)::type::NodeHandle);
+        });
+    };
+    ASSERT_EQ(index_width(3, 2), 4);
+    ASSERT_EQ(index_width(size_t{1} << 32, 2), 8);
+
+    auto weight_type_is_float = [](const EdgeList& edges, double max_relative_error)
+    {
+        return withNarrowestTypes<WeightedGraphSeparatedT>(3, edges, [](auto type)
+        {
+            using Graph = typename decltype(type)::type;
+            return std::is_same_v<Graph, WeightedGraphSeparatedT<uint32_t, float>>;
+        }, max_relative_error);
+    };
+    ASSERT_TRUE(weight_type_is_float(integer_weights, 0.0));
+    ASSERT_FALSE(weight_type_is_float(real_weights, 0.0));
+    ASSERT_TRUE(weight_type_is_float(real_weights, 1e-6));
+
+    EdgeList too_many_edges(300, Edge{0, 1, 1.});
+    ASSERT_THROW(AdjacencyArrayT<uint8_t>(2, too_many_edges), std::runtime_error);
+    ASSERT_THROW((WeightedGraphSeparatedT<uint8_t, float>(2, too_many_edges)), std::runtime_error);
+    ASSERT_THROW((WeightedGraphPairedT<uint8_t, float>(2, too_many_edges)), std::runtime_error);
+}
+
+TEST(QueryEngineTest, matches_serial_queries)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+    auto a = AdjacencyArray(n, elist);
+    auto dijh = DijkstraHelper<decltype(g)>(g);
+    auto bfsh = BFSHelper<decltype(a)>(a);
+
+    std::vector<std::pair<size_t, size_t>> queries;
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+            queries.emplace_back(s, t);
+
+    auto dijkstra_engine = QueryEngine<decltype(g), DijkstraHelper<decltype(g)>, DijkstraQuery>(g, 3);
+    auto bfs_engine = QueryEngine<decltype(a), BFSHelper<decltype(a)>, BFSQuery>(a, 3);
+    ASSERT_EQ(dijkstra_engine.numThreads(), 3);
+
+    // the workers are reused for every batch
+    for (int repetition = 0; repetition < 2; ++repetition)
+    {
+        auto dijkstra_batch = dijkstra_engine.run(queries);
+        auto bfs_batch = bfs_engine.run(queries);
+        ASSERT_EQ(dijkstra_batch.results.size(), queries.size());
+        ASSERT_EQ(bfs_batch.results.size(), queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            auto [s, t] = queries[i];
+            ASSERT_EQ(dijkstra_batch.results[i], dijh.dijkstra(g.node(s), g.node(t)));
+            ASSERT_EQ(bfs_batch.results[i], bfsh.bfs(a.node(s), a.node(t)));
+        }
+        ASSERT_LE(dijkstra_batch.p50_us, dijkstra_batch.p99_us);
+        ASSERT_LE(dijkstra_batch.p99_us, dijkstra_batch.p999_us);
+    }
+
+    ASSERT_TRUE(dijkstra_engine.run({}).results.empty());
+}
+
+struct FailingHelper {
+    static inline std::atomic<int> num_constructed{0};
+
+    // the second helper of an engine cannot be constructed
+    template<class Graph>
+    explicit FailingHelper(const Graph &) {
+        if (++num_constructed == 2) throw std::runtime_error("helper");
+    }
+};
+
+struct ZeroQuery {
+    template<class Helper, class NodeHandle>
+    int operator()(Helper &, NodeHandle, NodeHandle) const {
+        return 0;
+    }
+};
+
+TEST(QueryEngineTest, failing_helper)
+{
+    auto [elist, n] = readEdges("../data/test_graph.graph");
+    auto g = WeightedGraphSeparated(n, elist);
+    using Engine = QueryEngine<decltype(g), FailingHelper, ZeroQuery>;
+
+    FailingHelper::num_constructed = 0;
+    ASSERT_THROW(Engine(g, 3), std::runtime_error);
+    FailingHelper::num_constructed = 0;
+    auto engine = Engine(g, 1);
+    ASSERT_EQ(engine.run({{0, 1}}).results, std::vector<int>{0});
+}
+
+TEST(QueryEngineTest, percentile)
+{
+    std::vector<double> values(1000);
+    std::iota(values.begin(), values.end(), 1.0);
+    std::shuffle(values.begin(), values.end(), std::mt19937_64(0));
+    ASSERT_EQ(percentile(values, 0.5), 500.0);
+    ASSERT_EQ(percentile(values, 0.99), 990.0);
+    ASSERT_EQ(percentile(values, 0.999), 999.0);
+    ASSERT_EQ(percentile(values, 1.0), 1000.0);
+    ASSERT_EQ(percentile(values, 0.0), 1.0);
+    ASSERT_EQ(percentile({3.0, 1.0, 2.0}, 0.5), 2.0);
+    ASSERT_EQ(percentile({3.0, 1.0, 2.0}, 0.999), 3.0);
+    ASSERT_EQ(percentile({}, 0.5), 0.0);
+}
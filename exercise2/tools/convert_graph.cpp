@@ -0,0 +1,51 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../implementation/edge_list.hpp"
+#include "../implementation/parallel_read_edges.hpp"
+#include "../implementation/binary_graph.hpp"
+
+
+// Converts a text edge list ("n" followed by "from to length" lines) into the binary CSR format of binary_graph.hpp.
+//
+// usage: convert_graph <input.graph> <output.bin> [-u32 | -u64] [-unweighted]
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <input.graph> <output.bin> [-u32 | -u64] [-unweighted]" << std::endl;
+        return 1;
+    }
+
+    std::string input = argv[1];
+    std::string output = argv[2];
+    std::uint32_t index_width = 8;
+    bool weighted = true;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-u32") {
+            index_width = 4;
+        } else if (arg == "-u64") {
+            index_width = 8;
+        } else if (arg == "-unweighted") {
+            weighted = false;
+        } else {
+            std::cerr << "unknown argument " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const auto [edges, num_nodes] = readEdgesParallel(input);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    writeBinaryGraph(output, num_nodes, edges, index_width, weighted);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "n=" << num_nodes << " m=" << edges.size() << " index_width=" << index_width
+              << " weighted=" << weighted << "\n"
+              << "read " << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << " ms, "
+              << "write " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << " ms"
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware event counters of the calling thread via perf_event_open(2):
+/*
+  PerfCounters counters;
+  counters.start();
+  run();
+  auto sample = counters.stop();  // sample.instructions, sample.llc_misses
+*/
+// Only the events of the thread that constructed the counters are counted, work done by OpenMP threads is not included.
+// Opening an event fails without permission (see /proc/sys/kernel/perf_event_paranoid), in virtual machines and on
+// other platforms. Such events are reported as -1, so a benchmark still runs without them.
+
+class PerfCounters {
+public:
+    struct Sample {
+        std::int64_t instructions{-1};
+        std::int64_t llc_misses{-1};
+    };
+
+    PerfCounters() {
+        instructions_fd = open(Event::instructions);
+        llc_misses_fd = open(Event::llc_misses);
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    ~PerfCounters() {
+        close(instructions_fd);
+        close(llc_misses_fd);
+    }
+
+    // true if at least one event could be opened
+    [[nodiscard]] bool available() const {
+        return instructions_fd >= 0 || llc_misses_fd >= 0;
+    }
+
+    void start() {
+        for (auto fd: {instructions_fd, llc_misses_fd}) control(fd, Control::reset);
+        for (auto fd: {instructions_fd, llc_misses_fd}) control(fd, Control::enable);
+    }
+
+    Sample stop() {
+        for (auto fd: {instructions_fd, llc_misses_fd}) control(fd, Control::disable);
+        return {read(instructions_fd), read(llc_misses_fd)};
+    }
+
+private:
+    enum class Event {
+        instructions, llc_misses
+    };
+
+    enum class Control {
+        reset, enable, disable
+    };
+
+#if defined(__linux__)
+    static int open(Event event) {
+        perf_event_attr attr{};
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        // the generic cache miss event counts last level cache misses on most processors
+        attr.config = event == Event::instructions ? PERF_COUNT_HW_INSTRUCTIONS : PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static void close(int fd) {
+        if (fd >= 0) ::close(fd);
+    }
+
+    static void control(int fd, Control c) {
+        if (fd < 0) return;
+        switch (c) {
+            case Control::reset:
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                break;
+            case Control::enable:
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                break;
+            case Control::disable:
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                break;
+        }
+    }
+
+    static std::int64_t read(int fd) {
+        std::uint64_t value = 0;
+        if (fd < 0 || ::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return -1;
+        return static_cast<std::int64_t>(value);
+    }
+#else
+    static int open(Event) { return -1; }
+
+    static void close(int) {}
+
+    static void control(int, Control) {}
+
+    static std::int64_t read(int) { return -1; }
+#endif
+
+    int instructions_fd{-1};
+    int llc_misses_fd{-1};
+};
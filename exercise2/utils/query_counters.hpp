@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+
+// Counts the work of a query without changing the helpers. The graph and the priority queue of a helper are replaced by
+// wrappers that count the calls of the calling thread:
+/*
+  CountingGraph<WeightedGraphSeparated> counting_graph(graph);
+  DijkstraHelper<CountingGraph<WeightedGraphSeparated>, CountingQueue<IndexedPriorityQueue<...>>> helper(counting_graph);
+  query_counters = {};
+  helper.dijkstra(counting_graph.node(s), counting_graph.node(t));
+  // query_counters.settled_nodes, query_counters.relaxed_edges, query_counters.queue_operations
+*/
+// A node counts as settled when its edges are scanned (beginEdges) and an edge as relaxed when its head is read
+// (edgeHead). Queue operations are the calls of push, pushOrChangePriority and pop. The wrappers cost a few
+// instructions per call, so queries should be timed on the original graph.
+
+struct QueryCounters {
+    std::size_t settled_nodes{0};
+    std::size_t relaxed_edges{0};
+    std::size_t queue_operations{0};
+};
+
+inline thread_local QueryCounters query_counters{};
+
+
+template<class GraphClass>
+class CountingGraph {
+public:
+    using NodeHandle = typename GraphClass::NodeHandle;
+    using EdgeIterator = typename GraphClass::EdgeIterator;
+
+    explicit CountingGraph(const GraphClass &graph) : graph(graph) {}
+
+    [[nodiscard]] decltype(auto) numNodes() const { return graph.numNodes(); }
+
+    [[nodiscard]] decltype(auto) node(std::size_t id) const { return graph.node(id); }
+
+    [[nodiscard]] decltype(auto) nodeId(NodeHandle n) const { return graph.nodeId(n); }
+
+    [[nodiscard]] decltype(auto) beginEdges(NodeHandle n) const {
+        query_counters.settled_nodes++;
+        return graph.beginEdges(n);
+    }
+
+    [[nodiscard]] decltype(auto) endEdges(NodeHandle n) const { return graph.endEdges(n); }
+
+    [[nodiscard]] decltype(auto) edgeHead(EdgeIterator e) const {
+        query_counters.relaxed_edges++;
+        return graph.edgeHead(e);
+    }
+
+    [[nodiscard]] decltype(auto) edgeWeight(EdgeIterator e) const { return graph.edgeWeight(e); }
+
+private:
+    const GraphClass &graph;
+};
+
+
+template<class Queue>
+class CountingQueue : public Queue {
+public:
+    using Queue::Queue;
+
+    template<class K, class V>
+    void push(K key, V value) {
+        query_counters.queue_operations++;
+        Queue::push(key, value);
+    }
+
+    template<class K, class V>
+    void pushOrChangePriority(K key, V value) {
+        query_counters.queue_operations++;
+        Queue::pushOrChangePriority(key, value);
+    }
+
+    auto pop() {
+        query_counters.queue_operations++;
+        return Queue::pop();
+    }
+};
@@ -42,8 +42,8 @@ def generate_graph(num_components, num_nodes_per_component, num_avg_degree) -> P
 
 def run_experiment(task: str, graph: Path, num_threads: int, thread_range: bool, num_iterations: int, header: bool,
                    output_file):
-    assert task in "abcdef"
-    suffixes = dict(a="_sequential", b="_b", c="_c", d="_d", e="_e", f="")
+    assert task in "abcdefg"
+    suffixes = dict(a="_sequential", b="_b", c="_c", d="_d", e="_e", f="", g="_g")
     benchmark_executable = BUILD_DIR / ("benchmark_dynamic_connectivity" + suffixes[task])
 
     assert benchmark_executable.exists()
@@ -47,9 +47,10 @@ void DynamicConnectivity::addEdges(const EdgeList &edges) {
 
 
     auto is_root = [&](Node u) { return is_rank_repr(union_find[u]); };
+    auto tree_size = [&](Node u) { return tree_sizes[u].load(std::memory_order_relaxed); };
 
     parallel_build_adj_array(n, filtered_edges, num_filtered_edges.load(), adj_index, adj_counter, adj_edges);
-    parallel_bfs_from_roots(n, is_root, adj_index, adj_edges, bfs_frontiers, bfs_next_frontiers, bfs_visited,
+    parallel_bfs_from_roots(n, is_root, tree_size, adj_index, adj_edges, bfs_frontiers, bfs_next_frontiers,
                             bfs_parents);
 }
 
@@ -85,18 +86,32 @@ bool DynamicConnectivity::unite(Node a, Node b) {
         assert(a >= 0 && b >= 0 && rank_a >= 1 && rank_b >= 1);
         if (a == b) return false;
         if (rank_a < rank_b) {
-            if (union_find[a].compare_exchange_strong(rank_a_repr, b)) return true;
+            if (union_find[a].compare_exchange_strong(rank_a_repr, b)) {
+                link_tree_sizes(a, b);
+                return true;
+            }
         } else if (rank_a > rank_b) {
-            if (union_find[b].compare_exchange_strong(rank_b_repr, a)) return true;
+            if (union_find[b].compare_exchange_strong(rank_b_repr, a)) {
+                link_tree_sizes(b, a);
+                return true;
+            }
         } else {
             if (a < b && union_find[a].compare_exchange_strong(rank_a_repr, b)) {
                 union_find[b].compare_exchange_strong(rank_b_repr, to_rank_repr(rank_b + 1));
+                link_tree_sizes(a, b);
                 return true;
             }
             if (a > b && union_find[b].compare_exchange_strong(rank_b_repr, a)) {
                 union_find[a].compare_exchange_strong(rank_a_repr, to_rank_repr(rank_a + 1));
+                link_tree_sizes(b, a);
                 return true;
             }
         }
     }
-}
\ No newline at end of file
+}
+
+void DynamicConnectivity::link_tree_sizes(Node child, Node root) {
+    auto is_root = [&](Node u) { return is_rank_repr(union_find[u].load()); };
+    auto find_root = [&](Node u) { return find_representative(u); };
+    add_tree_size(tree_sizes, root, tree_sizes[child].exchange(0), is_root, find_root);
+}
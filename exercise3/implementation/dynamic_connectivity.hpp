@@ -2,20 +2,20 @@
 
 #undef DC_F
 
-#if defined(DC_SEQUENTIAL) + defined(DC_A) + defined(DC_B) + defined(DC_C) + defined(DC_D) + defined(DC_E) + defined(DC_F) > 1
+#if defined(DC_SEQUENTIAL) + defined(DC_A) + defined(DC_B) + defined(DC_C) + defined(DC_D) + defined(DC_E) + defined(DC_F) + defined(DC_G) > 1
 #error Please choose at most one implementation
 #endif
 
 #if defined(DC_SEQUENTIAL) || defined(DC_A)
 #include "implementation/dynamic_connectivity_sequential.hpp"
-#elif defined(DC_B) || defined(DC_C) || defined(DC_D) || defined(DC_E)
+#elif defined(DC_B) || defined(DC_C) || defined(DC_D) || defined(DC_E) || defined(DC_G)
 #include "implementation/dynamic_connectivity_mt.hpp"
 #else
 #if !defined(DC_F)
 #define DC_F
 #warning Default choice: DC_F \
          dynamic_connectivity.cpp is the corresponing .cpp file \
-         Specify DC_A / DC_SEQUENTIAL, DC_B, DC_C, DC_D, DC_E of DC_F explicitly to silency warning
+         Specify DC_A / DC_SEQUENTIAL, DC_B, DC_C, DC_D, DC_E, DC_F or DC_G explicitly to silency warning
 #endif
 
 #include <atomic>
@@ -67,6 +67,7 @@ public:
             throw std::runtime_error("Node type to small. Change Node and AdjIndex to be larger types.");
 
         union_find = allocation::allocate_at_least<std::atomic<Node>>(n);
+        tree_sizes = allocation::allocate_at_least<std::atomic<Node>>(n);
 
         filtered_edges = allocation::allocate_at_least<std::pair<Node, Node>>(n);
         filtered_edges_per_thread.resize(omp_get_max_threads());
@@ -87,6 +88,7 @@ public:
 #pragma omp for
             for (Node u = 0; u < n; ++u) {
                 ::new(&union_find[u]) std::atomic<Node>(to_rank_repr(1));
+                ::new(&tree_sizes[u]) std::atomic<Node>(1);
             }
 
 #pragma omp for
@@ -105,6 +107,7 @@ public:
 
     ~DynamicConnectivity() {
         free(union_find);
+        free(tree_sizes);
 
         free(filtered_edges);
         num_filtered_edges.store(0);
@@ -143,6 +146,8 @@ private:
 
     // union find
     std::atomic<Node> *union_find{nullptr};
+    // number of nodes in the tree of every root, see add_tree_size
+    std::atomic<Node> *tree_sizes{nullptr};
 
     // preliminary edge list
     std::pair<Node, Node> *filtered_edges{nullptr};
@@ -157,7 +162,6 @@ private:
     // bfs
     std::vector<std::vector<Node>> bfs_frontiers;
     std::vector<std::vector<Node>> bfs_next_frontiers;
-    std::vector<std::vector<bool>> bfs_visited;
     Node *bfs_parents{nullptr};
 
 
@@ -168,6 +172,9 @@ private:
 
     bool unite(Node a, Node b);
 
+    // moves the tree size of child to root, after child has been linked below root
+    void link_tree_sizes(Node child, Node root);
+
     constexpr static bool is_rank_repr(Node repr) {
         return repr < 0;
     }
@@ -53,6 +53,9 @@ bool DynamicConnectivity::unite(Node a, Node b) {
 
         if (a_rank < b_rank) std::swap(a, b);
         union_find_parents[b] = a;
+        // only threads holding the locks of both roots change their sizes
+        tree_sizes[a].store(tree_sizes[a].load(std::memory_order_relaxed) +
+                            tree_sizes[b].load(std::memory_order_relaxed), std::memory_order_relaxed);
         if (a_rank == b_rank) {
             union_find_ranks[a]++;
         }
@@ -0,0 +1,53 @@
+#include <numeric>
+#include <cassert>
+#include <iostream>
+
+#include "dynamic_connectivity_mt.hpp"
+#include "graph_algorithms.hpp"
+#include "omp.h"
+
+
+DynamicConnectivity::Node DynamicConnectivity::find_representative(Node node) const {
+    Node root = union_find_parents[node].load(std::memory_order_relaxed);
+    while (root != node) {
+        node = root;
+        root = union_find_parents[root].load(std::memory_order_relaxed);
+    }
+    return root;
+}
+
+DynamicConnectivity::Node DynamicConnectivity::find_representative_and_compress(Node node) {
+    // Path splitting: every node on the path is linked to its grandparent. A failed CAS means another thread changed
+    // the parent in the meantime, which is fine as parents only move closer to the root.
+    while (true) {
+        Node parent = union_find_parents[node].load(std::memory_order_relaxed);
+        Node grandparent = union_find_parents[parent].load(std::memory_order_relaxed);
+        if (parent == grandparent) return parent;
+        union_find_parents[node].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+        node = parent;
+    }
+}
+
+bool DynamicConnectivity::unite(Node a, Node b) {
+    while (true) {
+        a = find_representative_and_compress(a);
+        b = find_representative_and_compress(b);
+
+        if (a == b) {
+            return false;
+        }
+
+        // Link the root with lower priority. Parents always have a higher priority than their children.
+        if (priority(a) > priority(b)) std::swap(a, b);
+        assert(priority(a) < priority(b));
+
+        // sequentially consistent, so that add_tree_size sees the link
+        Node expected = a;
+        if (union_find_parents[a].compare_exchange_strong(expected, b)) {
+            auto is_root = [&](Node u) { return union_find_parents[u].load() == u; };
+            auto find_root = [&](Node u) { return find_representative(u); };
+            add_tree_size(tree_sizes, b, tree_sizes[a].exchange(0), is_root, find_root);
+            return true;
+        }
+    }
+}
@@ -3,13 +3,14 @@
 #include <atomic>
 #include <mutex>
 #include <cassert>
+#include <cstdint>
 
 #include "edge_list.hpp"
 #include "graph_algorithms.hpp"
 #include "utils/allocation.h"
 
 
-#if defined(DC_C) || defined(DC_D) || defined(DC_E)
+#if defined(DC_C) || defined(DC_D) || defined(DC_E) || defined(DC_G)
 #define USE_COMPRESSION
 #endif
 
@@ -17,6 +18,14 @@
 #define USE_RANKS
 #endif
 
+#if defined(DC_G)
+#define USE_LOCK_FREE
+#endif
+
+#if defined(DC_E) || defined(DC_G)
+#define USE_TREE_SIZES
+#endif
+
 class DynamicConnectivity {
 public:
     using Node = int;
@@ -25,14 +34,22 @@ public:
 
     DynamicConnectivity() = default;
 
-    explicit DynamicConnectivity(long num_nodes) : n(num_nodes), union_find_mutexes(num_nodes) {
+    explicit DynamicConnectivity(long num_nodes) : n(num_nodes) {
         if (num_nodes >= std::numeric_limits<Node>::max())
             throw std::runtime_error("Node type to small");
 
+#ifdef USE_LOCK_FREE
+        union_find_parents = allocation::allocate_at_least<std::atomic<Node>>(n);
+#else
         union_find_parents = allocation::allocate_at_least<Node>(n);
+        union_find_mutexes = std::vector<std::mutex>(num_nodes);
+#endif
 #ifdef USE_RANKS
         union_find_ranks = allocation::allocate_at_least<Rank>(n);
 #endif
+#ifdef USE_TREE_SIZES
+        tree_sizes = allocation::allocate_at_least<std::atomic<Node>>(n);
+#endif
 
         filtered_edges = allocation::allocate_at_least<std::pair<Node, Node>>(n);
         filtered_edges_per_thread.resize(omp_get_max_threads());
@@ -60,6 +77,12 @@ public:
                 ::new(&union_find_ranks[u]) std::atomic<Rank>(0);
             }
 #endif
+#ifdef USE_TREE_SIZES
+#pragma omp for
+            for (Node u = 0; u < n; ++u) {
+                ::new(&tree_sizes[u]) std::atomic<Node>(1);
+            }
+#endif
 
             // Will be written again in bfs, but this way parentOf() is valid without a call to addEdges()
 #pragma omp for
@@ -80,6 +103,9 @@ public:
         free(union_find_parents);
 #ifdef USE_RANKS
         free(union_find_ranks);
+#endif
+#ifdef USE_TREE_SIZES
+        free(tree_sizes);
 #endif
         free(filtered_edges);
         num_filtered_edges.store(0);
@@ -132,10 +158,11 @@ public:
 
         auto is_root = [&](Node u) { return union_find_parents[u] == u; };
 
-#ifdef DC_E
+#if defined(DC_E) || defined(DC_G)
+        auto tree_size = [&](Node u) { return tree_sizes[u].load(std::memory_order_relaxed); };
         parallel_build_adj_array(n, filtered_edges, num_filtered_edges.load(), adj_index, adj_counter, adj_edges);
-        parallel_bfs_from_roots(n, is_root, adj_index, adj_edges, bfs_frontiers, bfs_next_frontiers, bfs_visited,
-                            bfs_parents);
+        parallel_bfs_from_roots(n, is_root, tree_size, adj_index, adj_edges, bfs_frontiers, bfs_next_frontiers,
+                                bfs_parents);
 #else
         sequential_build_adj_array(n, filtered_edges, num_filtered_edges.load(), adj_index, adj_counter, adj_edges);
         sequential_bfs_from_roots(n, is_root, adj_index, adj_edges, bfs_frontiers, bfs_next_frontiers,
@@ -160,11 +187,21 @@ private:
     Node n{0};
 
     // union find
+#ifdef USE_LOCK_FREE
+    // Roots are linked by CAS on their own entry, so no mutex per node is needed. A root is always linked below a root
+    // of higher priority, which keeps the trees acyclic without a rank array.
+    std::atomic<Node> *union_find_parents{nullptr};
+#else
     Node *union_find_parents{nullptr};
+    std::vector<std::mutex> union_find_mutexes;
+#endif
 #ifdef USE_RANKS
     Rank *union_find_ranks{nullptr};
 #endif
-    std::vector<std::mutex> union_find_mutexes;
+#ifdef USE_TREE_SIZES
+    // number of nodes in the tree of every root, updated when a root is linked
+    std::atomic<Node> *tree_sizes{nullptr};
+#endif
 
     // preliminary edge list
     std::pair<Node, Node> *filtered_edges{nullptr};
@@ -193,8 +230,20 @@ private:
 
     bool unite(Node a, Node b);
 
+#ifdef USE_LOCK_FREE
+
+    // Random but fixed priority of a node. The hash is a bijection on 32 bit values, so no two nodes have the same
+    // priority.
+    static constexpr std::uint32_t priority(Node node) {
+        auto x = static_cast<std::uint32_t>(node);
+        x = (x ^ (x >> 16)) * 0x45d9f3bU;
+        x = (x ^ (x >> 16)) * 0x45d9f3bU;
+        return x ^ (x >> 16);
+    }
 
+#else
 #define TRY_LOCK_TREES_C
+#endif
 #ifdef TRY_LOCK_TREES_A
 
     bool try_lock_trees(Node &a, Node &b) {
@@ -357,3 +406,5 @@ private:
 
 #undef USE_COMPRESSION
 #undef USE_RANKS
+#undef USE_LOCK_FREE
+#undef USE_TREE_SIZES
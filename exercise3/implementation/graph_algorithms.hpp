@@ -1,6 +1,7 @@
 #ifndef BFS_HPP
 #define BFS_HPP
 
+#include <algorithm>
 #include <vector>
 #include <atomic>
 
@@ -14,7 +15,10 @@ void parallel_build_adj_array(Node n, const std::pair<Node, Node> *filtered_edge
                               AdjIndex *adj_index,
                               std::atomic<AdjIndex> *adj_counter,
                               Node *adj_edges) {
-    #pragma omp parallel default(none) shared(n, filtered_edges, m, adj_index, adj_counter, adj_edges)
+    // sum of the counters in the blocks before block i, one block per thread
+    std::vector<AdjIndex> block_offsets;
+
+    #pragma omp parallel default(none) shared(n, filtered_edges, m, adj_index, adj_counter, adj_edges, block_offsets)
     {
         #pragma omp for
         for (Node u = 0; u < n + 1; ++u) {
@@ -27,29 +31,47 @@ void parallel_build_adj_array(Node n, const std::pair<Node, Node> *filtered_edge
         #pragma omp for
         for (std::size_t i = 0; i < m; ++i) {
             auto[a, b] = filtered_edges[i];
-            adj_counter[a + 1].fetch_add(1);
-            adj_counter[b + 1].fetch_add(1);
+            adj_counter[a + 1].fetch_add(1, std::memory_order_relaxed);
+            adj_counter[b + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Blocked two-pass prefix sum. Each thread sums its block, the block sums are scanned sequentially, and each
+        // thread scans its block again starting at the offset of the block. The counters are only read and written by
+        // the thread owning the block, so relaxed loads and stores suffice between the barriers.
+        const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+        const auto id = static_cast<std::size_t>(omp_get_thread_num());
+        const auto size = static_cast<std::size_t>(n) + 1;
+        const std::size_t block_begin = size * id / num_threads;
+        const std::size_t block_end = size * (id + 1) / num_threads;
+
+        #pragma omp single
+        block_offsets.assign(num_threads + 1, 0);
+
+        AdjIndex block_sum = 0;
+        for (std::size_t i = block_begin; i < block_end; ++i) {
+            block_sum += adj_counter[i].load(std::memory_order_relaxed);
         }
+        block_offsets[id + 1] = block_sum;
 
         #pragma omp barrier
 
         #pragma omp single
         {
-            for (std::size_t i = 1; i < static_cast<std::size_t>(n) + 1; i++) {
-                adj_counter[i] += adj_counter[i - 1];
+            for (std::size_t i = 1; i < num_threads + 1; ++i) {
+                block_offsets[i] += block_offsets[i - 1];
             }
         }
-        // See https://stackoverflow.com/questions/35821844/parallelization-of-a-prefix-sum-openmp
-        // for parallel prefix sum
 
-        #pragma omp barrier
-
-        #pragma omp for
-        for (std::size_t i = 0; i < static_cast<std::size_t>(n) + 1; ++i) {
+        AdjIndex sum = block_offsets[id];
+        for (std::size_t i = block_begin; i < block_end; ++i) {
+            sum += adj_counter[i].load(std::memory_order_relaxed);
+            adj_counter[i].store(sum, std::memory_order_relaxed);
             // adj_index[i] will not be modified after this store
-            adj_index[i] = adj_counter[i].load();
+            adj_index[i] = sum;
         }
 
+        #pragma omp barrier
+
         assert(adj_counter[0] == 0);
         assert(adj_counter[n] == (AdjIndex) (2 * m));
 
@@ -60,8 +82,8 @@ void parallel_build_adj_array(Node n, const std::pair<Node, Node> *filtered_edge
             auto[a, b] = filtered_edges[i];
 
             // adj_counter[a] and adj_counter[b] might be modified later
-            AdjIndex a_index = adj_counter[a].fetch_add(1);
-            AdjIndex b_index = adj_counter[b].fetch_add(1);
+            AdjIndex a_index = adj_counter[a].fetch_add(1, std::memory_order_relaxed);
+            AdjIndex b_index = adj_counter[b].fetch_add(1, std::memory_order_relaxed);
 
             assert(a_index < static_cast<AdjIndex>(2 * n));
             assert(b_index < static_cast<AdjIndex>(2 * n));
@@ -118,78 +140,155 @@ void sequential_build_adj_array(Node n, const std::pair<Node, Node> *filtered_ed
 }
 
 
-template<class Node, class AdjIndex, class F>
+/**
+ * Adds amount to the tree size of root after a link. If root has been linked below another node in the meantime, the
+ * amount is carried on to the new root. The thread that linked root carries everything that was added before its own
+ * exchange, every later adder sees that root is no longer a root. So the sizes at the roots are exact once all links
+ * are done, without locks. is_root has to be sequentially consistent with the linking CAS.
+ */
+template<class Node, class Size, class R, class F>
+void add_tree_size(std::atomic<Size> *tree_sizes, Node root, Size amount, R is_root, F find_root) {
+    while (amount != 0) {
+        tree_sizes[root].fetch_add(amount);
+        if (is_root(root)) return;
+        amount = tree_sizes[root].exchange(0);
+        root = find_root(root);
+    }
+}
+
+
+/**
+ * BFS forest of the forest stored in the adjacency array. As the graph is a forest, the only visited neighbor of a node
+ * is its parent, so no visited array is needed. tree_size(root) is the number of nodes in the tree of root, as tracked
+ * by the union-find. Small trees are searched by a single thread each, and all large trees together by one
+ * level-synchronous BFS, so that a giant component is also searched by all threads.
+ */
+template<class Node, class AdjIndex, class F, class S>
 void parallel_bfs_from_roots(Node n,
                              F is_root,
+                             S tree_size,
                              const AdjIndex *const adj_index,
                              const Node *const adj_edges,
                              std::vector<std::vector<Node>> &bfs_frontiers,
                              std::vector<std::vector<Node>> &bfs_next_frontiers,
-                             std::vector<std::vector<bool>> &bfs_visited,
                              Node *bfs_parents) {
-
-    #pragma omp parallel for default(none) shared(n, bfs_parents)
-    for (Node u = 0; u < n; ++u) {
-        ::new(&bfs_parents[u]) std::atomic<Node>(-1);
-    }
-
-    bfs_frontiers.resize(omp_get_max_threads());
-    bfs_next_frontiers.resize(omp_get_max_threads());
-    bfs_visited.resize(omp_get_max_threads());
-
-    #pragma omp parallel default(none) shared(n, is_root, adj_index, adj_edges, bfs_frontiers, bfs_next_frontiers, bfs_visited, bfs_parents)
+    const auto max_num_threads = static_cast<std::size_t>(omp_get_max_threads());
+    const auto large_tree_size = std::max<std::size_t>(1 << 12, static_cast<std::size_t>(n) / (4 * max_num_threads));
+
+    // One buffer per thread and the shared frontiers of the level-synchronous BFS at the back
+    bfs_frontiers.resize(max_num_threads + 1);
+    bfs_next_frontiers.resize(max_num_threads + 1);
+    auto &frontier = bfs_frontiers.back();
+    auto &next_frontier = bfs_next_frontiers.back();
+
+    std::vector<Node> large_roots;
+    std::vector<std::size_t> next_frontier_offsets;
+    // nodes of the large trees that have not been reached yet
+    std::size_t large_tree_nodes = 0;
+
+    #pragma omp parallel default(none) shared(n, is_root, tree_size, adj_index, adj_edges, bfs_frontiers, \
+            bfs_next_frontiers, bfs_parents, large_tree_size, frontier, next_frontier, large_roots, \
+            next_frontier_offsets, large_tree_nodes)
     {
-        int id = omp_get_thread_num();
-        std::vector<Node> frontier, next_frontier;
-        std::vector<bool> visited;
+        const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+        const auto id = static_cast<std::size_t>(omp_get_thread_num());
+        std::vector<Node> local_frontier, local_next_frontier;
 
         // reuse of previously allocated memory
         // swapped with local variable to prevent false sharing between threads
-        std::swap(frontier, bfs_frontiers[id]);
-        std::swap(next_frontier, bfs_next_frontiers[id]);
-        std::swap(visited, bfs_visited[id]);
+        std::swap(local_frontier, bfs_frontiers[id]);
+        std::swap(local_next_frontier, bfs_next_frontiers[id]);
 
-        assert(frontier.empty());
-        assert(next_frontier.empty());
-        visited.assign(n, false);
+        assert(local_frontier.empty());
+        assert(local_next_frontier.empty());
 
-        #pragma omp for schedule(dynamic)
+        // Every node is either a root or reached from its parent, so bfs_parents needs no initialization.
+        #pragma omp for schedule(dynamic, 1024)
         for (Node u = 0; u < n; ++u) {
-            assert(frontier.empty());
-            assert(next_frontier.empty());
-
-            if (is_root(u)) {
-                frontier.push_back(u);
-                visited[u] = true;
-
-                std::size_t distance = 1;
-
-                while (!frontier.empty()) {
-                    while (!frontier.empty()) {
-                        Node node = frontier.back();
-                        frontier.pop_back();
-
-                        for (AdjIndex i = adj_index[node]; i < adj_index[node + 1]; ++i) {
-                            auto neighbor = adj_edges[i];
-                            if (!visited[neighbor]) {
-                                visited[neighbor] = true;
-                                bfs_parents[neighbor] = node;
-                                next_frontier.push_back(neighbor);
-                            }
+            if (!is_root(u)) continue;
+
+            if (static_cast<std::size_t>(tree_size(u)) >= large_tree_size) {
+                #pragma omp critical
+                large_roots.push_back(u);
+                continue;
+            }
+
+            bfs_parents[u] = -1;
+            local_frontier.push_back(u);
+            [[maybe_unused]] std::size_t reached = 0;
+
+            while (!local_frontier.empty()) {
+                while (!local_frontier.empty()) {
+                    Node node = local_frontier.back();
+                    local_frontier.pop_back();
+                    reached++;
+
+                    for (AdjIndex i = adj_index[node]; i < adj_index[node + 1]; ++i) {
+                        auto neighbor = adj_edges[i];
+                        if (neighbor != bfs_parents[node]) {
+                            bfs_parents[neighbor] = node;
+                            local_next_frontier.push_back(neighbor);
                         }
                     }
-                    distance++;
-                    std::swap(frontier, next_frontier);
                 }
+                std::swap(local_frontier, local_next_frontier);
+            }
+            assert(reached == static_cast<std::size_t>(tree_size(u)));
+        }
+
+        #pragma omp single
+        {
+            next_frontier_offsets.assign(num_threads + 1, 0);
+            frontier.assign(large_roots.begin(), large_roots.end());
+            for (auto root: large_roots) {
+                bfs_parents[root] = -1;
+                large_tree_nodes += static_cast<std::size_t>(tree_size(root)) - 1;
+            }
+        }
+
+        while (!frontier.empty()) {
+            #pragma omp for schedule(dynamic, 256)
+            for (std::size_t j = 0; j < frontier.size(); ++j) {
+                Node node = frontier[j];
+                for (AdjIndex i = adj_index[node]; i < adj_index[node + 1]; ++i) {
+                    auto neighbor = adj_edges[i];
+                    if (neighbor != bfs_parents[node]) {
+                        // neighbor is only reached from node
+                        bfs_parents[neighbor] = node;
+                        local_next_frontier.push_back(neighbor);
+                    }
+                }
+            }
+
+            next_frontier_offsets[id + 1] = local_next_frontier.size();
+
+            #pragma omp barrier
 
-                assert(frontier.empty());
-                assert(next_frontier.empty());
+            #pragma omp single
+            {
+                for (std::size_t i = 1; i < num_threads + 1; ++i) {
+                    next_frontier_offsets[i] += next_frontier_offsets[i - 1];
+                }
+                next_frontier.resize(next_frontier_offsets[num_threads]);
+                large_tree_nodes -= next_frontier.size();
             }
+
+            std::copy(local_next_frontier.begin(), local_next_frontier.end(),
+                      next_frontier.begin() + static_cast<std::ptrdiff_t>(next_frontier_offsets[id]));
+            local_next_frontier.clear();
+
+            #pragma omp barrier
+
+            #pragma omp single
+            std::swap(frontier, next_frontier);
         }
 
-        std::swap(frontier, bfs_frontiers[id]);
-        std::swap(next_frontier, bfs_next_frontiers[id]);
-        std::swap(visited, bfs_visited[id]);
+        assert(local_frontier.empty());
+        assert(local_next_frontier.empty());
+        assert(large_tree_nodes == 0);
+
+        std::swap(local_frontier, bfs_frontiers[id]);
+        std::swap(local_next_frontier, bfs_next_frontiers[id]);
     }
 }
 
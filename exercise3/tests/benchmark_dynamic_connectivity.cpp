@@ -9,6 +9,7 @@
 
 #include "utils/commandline.hpp"
 #include "implementation/edge_list.hpp"
+#include "implementation/parallel_read_edges.hpp"
 
 constexpr std::string_view task() {
 #if defined(DC_SEQUENTIAL)
@@ -23,6 +24,8 @@ constexpr std::string_view task() {
     return "e";
 #elif defined(DC_F)
     return "f";
+#elif defined(DC_G)
+    return "g";
 #else
     static_assert(false);
 #endif
@@ -54,7 +57,7 @@ int main(int argn, char** argc) {
         std::cout << std::setw(10) << "time" << std::endl;
     }
 
-    auto [edges, num_nodes] = readEdges(graph_path);
+    auto [edges, num_nodes] = readEdgesParallel(graph_path);
 
     if (num_threads == -1) {
         num_threads = omp_get_max_threads();